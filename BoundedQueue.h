@@ -0,0 +1,111 @@
+// ------------------------------------------------ BoundedQueue.h -------------
+// Purpose - A fixed capacity queue for handing work from one thread to
+//              another.
+// -----------------------------------------------------------------------------
+// Assumptions -
+//
+// - T is cheap to copy (the pipeline passes pointers through it).
+//
+// Features -
+//
+// - push blocks while the queue is full, so a fast producer waits for a
+//   slow consumer instead of buffering without limit (backpressure).
+// - pop blocks while the queue is empty.
+// - close tells the consumer no more items are coming. pop returns false
+//   once the queue is closed and drained.
+// -----------------------------------------------------------------------------
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+template <typename T>
+class BoundedQueue {
+
+    private:
+        // Largest number of items held at once.
+        size_t capacity;
+        // Set by close, no push is allowed after it.
+        bool closed;
+        std::deque<T> items;
+        std::mutex lock;
+        // Signalled when an item is pushed or the queue is closed.
+        std::condition_variable notEmpty;
+        // Signalled when an item is popped.
+        std::condition_variable notFull;
+
+    public:
+        // ------------------------------------BoundedQueue---------------------
+        // Description: Constructor, capacity of 0 is treated as 1.
+        // ---------------------------------------------------------------------
+        explicit BoundedQueue(size_t capacity)
+            : capacity(capacity > 0 ? capacity : 1), closed(false)
+        {
+        }
+
+        // ------------------------------------push-----------------------------
+        // Description: Waits for room, then adds item to the back.
+        //              Returns false (and drops item) if the queue is closed.
+        // ---------------------------------------------------------------------
+        bool push(const T &item)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            while (!closed && items.size() >= capacity)
+            {
+                notFull.wait(guard);
+            }
+
+            if (closed)
+            {
+                return false;
+            }
+
+            items.push_back(item);
+            notEmpty.notify_one();
+
+            return true;
+        }
+
+        // ------------------------------------pop------------------------------
+        // Description: Waits for an item and removes it from the front.
+        //              Returns false when the queue is closed and empty.
+        // ---------------------------------------------------------------------
+        bool pop(T &item)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            while (!closed && items.empty())
+            {
+                notEmpty.wait(guard);
+            }
+
+            if (items.empty())
+            {
+                return false;
+            }
+
+            item = items.front();
+            items.pop_front();
+            notFull.notify_one();
+
+            return true;
+        }
+
+        // ------------------------------------close----------------------------
+        // Description: Marks the end of the input and wakes every waiter.
+        // ---------------------------------------------------------------------
+        void close()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+
+            closed = true;
+            notEmpty.notify_all();
+            notFull.notify_all();
+        }
+};
+
+#endif /* BOUNDEDQUEUE_H */
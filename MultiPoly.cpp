@@ -0,0 +1,1042 @@
+// ------------------------------------------------ MultiPoly.cpp --------------
+// Purpose - Implementation of MultiPoly
+// -----------------------------------------------------------------------------
+// Notes -
+//
+// - Build with -pthread, large operations use std::thread.
+// - Work below PARALLEL_WORK (terms touched) always runs on the calling
+//   thread, since starting threads costs more than it saves there.
+// -----------------------------------------------------------------------------
+
+#include "MultiPoly.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+typedef MultiPoly::Term Term;
+typedef std::unordered_map<uint64_t, uint64_t> TermTable;
+
+// Sums of polynomials in the last variable, keyed by the monomial of the
+// other variables. Entry k is the coefficient of (last variable)^k.
+typedef std::unordered_map<uint64_t, std::vector<uint64_t> > CoeffTable;
+
+static const size_t PARALLEL_WORK = 1 << 16;
+
+// A multivariate product goes through Poly when both sides have, on
+// average, at least this many terms per polynomial in the last variable.
+// Below that the Poly set up costs more than the hash tables.
+static const size_t RECURSIVE_GROUP_TERMS = 16;
+
+// Above this exponent evaluate uses std::pow instead of a table of powers.
+static const int POWER_TABLE_LIMIT = 1 << 20;
+
+// ------------------------------------workerCount------------------------------
+// Description: How many threads to use for an operation touching work terms.
+// -----------------------------------------------------------------------------
+static int workerCount(size_t work)
+{
+    if (work < PARALLEL_WORK)
+    {
+        return 1;
+    }
+
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    return int(std::min(hardware, work / PARALLEL_WORK));
+}
+
+// ------------------------------------runParallel------------------------------
+// Description: Calls task(t) for t = 0 .. threadCount - 1, each on its own
+//              thread (task 0 on the calling thread), and waits for all.
+// -----------------------------------------------------------------------------
+template <typename Task>
+static void runParallel(int threadCount, Task task)
+{
+    std::vector<std::thread> workers;
+
+    for (int t = 1; t < threadCount; t++)
+    {
+        workers.push_back(std::thread(task, t));
+    }
+
+    task(0);
+
+    for (size_t t = 0; t < workers.size(); t++)
+    {
+        workers[t].join();
+    }
+}
+
+// ------------------------------------greaterMonomial--------------------------
+// Description: Ordering of the terms vector, largest monomial first.
+// -----------------------------------------------------------------------------
+static bool greaterMonomial(const Term &left, uint64_t right)
+{
+    return left.monomial > right;
+}
+
+static bool greaterTerm(const Term &left, const Term &right)
+{
+    return left.monomial > right.monomial;
+}
+
+// ------------------------------------wrapToInt--------------------------------
+// Description: The low 32 bits of value as an int. Coefficients are added
+//              up as uint64_t, which wraps instead of overflowing, so the
+//              result is what int arithmetic that wrapped would give.
+//              Poly's tiledProduct uses unsigned lanes the same way.
+// -----------------------------------------------------------------------------
+static int wrapToInt(uint64_t value)
+{
+    return int(uint32_t(value));
+}
+
+// ------------------------------------mergeTerms-------------------------------
+// Description: Appends to result the sorted merge of [a, aEnd) and
+//              sign * [b, bEnd), adding like terms and dropping zeros.
+// -----------------------------------------------------------------------------
+static void mergeTerms(const Term* a, const Term* aEnd,
+                       const Term* b, const Term* bEnd,
+                       int sign, std::vector<Term> &result)
+{
+    while ((a != aEnd) && (b != bEnd))
+    {
+        if (a->monomial > b->monomial)
+        {
+            result.push_back(*a++);
+        }
+        else if (a->monomial < b->monomial)
+        {
+            Term term = *b++;
+            term.coefficient = wrapToInt(uint64_t(sign) * term.coefficient);
+            result.push_back(term);
+        }
+        else
+        {
+            Term term = *a++;
+            term.coefficient = wrapToInt(uint64_t(term.coefficient)
+                + uint64_t(sign) * (b++)->coefficient);
+
+            if (term.coefficient != 0)
+            {
+                result.push_back(term);
+            }
+        }
+    }
+
+    result.insert(result.end(), a, aEnd);
+
+    for (; b != bEnd; b++)
+    {
+        Term term = *b;
+        term.coefficient = wrapToInt(uint64_t(sign) * term.coefficient);
+        result.push_back(term);
+    }
+}
+
+// ------------------------------------ownerOf----------------------------------
+// Description: Which of threadCount threads adds up the terms of monomial.
+// -----------------------------------------------------------------------------
+static int ownerOf(uint64_t monomial, int threadCount)
+{
+    return int(((monomial * 0x9E3779B97F4A7C15ULL) >> 32) % threadCount);
+}
+
+// ------------------------------------addProduct-------------------------------
+// Description: Adds the coefficients of product into sum, growing sum
+//              if the product has a larger power.
+// -----------------------------------------------------------------------------
+static void addProduct(std::vector<uint64_t> &sum, const Poly &product)
+{
+    int power = product.getLargestPower();
+
+    if (sum.size() < size_t(power) + 1)
+    {
+        sum.resize(power + 1, 0);
+    }
+
+    for (int k = 0; k <= power; k++)
+    {
+        sum[k] += uint64_t(product.getCoeff(k));
+    }
+}
+
+// ------------------------------------mergeRuns--------------------------------
+// Description: Merges sorted runs that have no monomials in common into
+//              result, pairwise, freeing each run once it is merged.
+// -----------------------------------------------------------------------------
+static void mergeRuns(std::vector<std::vector<Term> > &runs,
+                      std::vector<Term> &result)
+{
+    int runCount = int(runs.size());
+
+    for (int width = 1; width < runCount; width *= 2)
+    {
+        for (int u = 0; u + width < runCount; u += 2 * width)
+        {
+            std::vector<Term> merged;
+            merged.reserve(runs[u].size() + runs[u + width].size());
+            mergeTerms(runs[u].data(), runs[u].data() + runs[u].size(),
+                       runs[u + width].data(),
+                       runs[u + width].data() + runs[u + width].size(),
+                       1, merged);
+            runs[u].swap(merged);
+            std::vector<Term>().swap(runs[u + width]);
+        }
+    }
+
+    result.swap(runs[0]);
+}
+
+// ------------------------------------tableToTerms-----------------------------
+// Description: Moves the non-zero entries of table into a sorted vector.
+// -----------------------------------------------------------------------------
+static void tableToTerms(const TermTable &table, std::vector<Term> &result)
+{
+    result.reserve(table.size());
+
+    for (TermTable::const_iterator it = table.begin(); it != table.end(); ++it)
+    {
+        int coefficient = wrapToInt(it->second);
+
+        if (coefficient != 0)
+        {
+            Term term = { it->first, coefficient };
+            result.push_back(term);
+        }
+    }
+
+    std::sort(result.begin(), result.end(), greaterTerm);
+}
+
+// ------------------------------------MultiPoly--------------------------------
+// Description: Constructor, the zero polynomial in varCount variables.
+//              Throws std::invalid_argument if varCount is not in
+//              1 .. MAX_VARIABLES.
+// -----------------------------------------------------------------------------
+MultiPoly::MultiPoly(int varCount)
+{
+    if ((varCount < 1) || (varCount > MAX_VARIABLES))
+    {
+        throw std::invalid_argument("MultiPoly: bad variable count");
+    }
+
+    this->varCount = varCount;
+    bitsPerVar = 64 / this->varCount;
+
+    // Exponents are ints, so never allow more than INT_MAX even when
+    // the field is wider.
+    maxExponent = INT_MAX;
+
+    if (bitsPerVar < 32)
+    {
+        maxExponent = (uint64_t(1) << bitsPerVar) - 1;
+    }
+}
+
+// ------------------------------------MultiPoly--------------------------------
+// Description: Converting Constructor, makes Poly's polynomial a
+//              polynomial in the given variable out of varCount.
+//              Throws std::overflow_error if a power does not fit.
+// -----------------------------------------------------------------------------
+MultiPoly::MultiPoly(const Poly& orig, int varCount, int variable)
+    : MultiPoly(varCount)
+{
+    if ((variable < 0) || (variable >= this->varCount))
+    {
+        throw std::invalid_argument("MultiPoly: no such variable");
+    }
+
+    int shift = (this->varCount - 1 - variable) * bitsPerVar;
+
+    // From the largest power down keeps terms sorted.
+    for (int i = orig.getLargestPower(); i >= 0; i--)
+    {
+        int coefficient = orig.getCoeff(i);
+
+        if (coefficient != 0)
+        {
+            if (uint64_t(i) > maxExponent)
+            {
+                throw std::overflow_error("MultiPoly: exponent too large");
+            }
+
+            Term term = { uint64_t(i) << shift, coefficient };
+            terms.push_back(term);
+        }
+    }
+}
+
+// ------------------------------------pack-------------------------------------
+// Description: Packs varCount exponents into one word, variable 0 highest.
+// Precondition: every exponent is between 0 and maxExponent.
+// -----------------------------------------------------------------------------
+uint64_t MultiPoly::pack(const int* exponents) const
+{
+    uint64_t monomial = 0;
+
+    for (int v = 0; v < varCount; v++)
+    {
+        monomial = (bitsPerVar < 64 ? monomial << bitsPerVar : 0)
+            | uint64_t(exponents[v]);
+    }
+
+    return monomial;
+}
+
+// ------------------------------------exponentOf-------------------------------
+// Description: Unpacks the exponent of one variable from a monomial.
+// -----------------------------------------------------------------------------
+int MultiPoly::exponentOf(uint64_t monomial, int variable) const
+{
+    if (bitsPerVar == 64)
+    {
+        return int(monomial);
+    }
+
+    int shift = (varCount - 1 - variable) * bitsPerVar;
+    uint64_t fieldMask = (uint64_t(1) << bitsPerVar) - 1;
+
+    return int((monomial >> shift) & fieldMask);
+}
+
+// ------------------------------------maxExponents-----------------------------
+// Description: Sets result[v] to the largest exponent of variable v in any
+//              term (0 for the zero polynomial).
+// -----------------------------------------------------------------------------
+void MultiPoly::maxExponents(uint64_t* result) const
+{
+    for (int v = 0; v < varCount; v++)
+    {
+        result[v] = 0;
+    }
+
+    for (size_t i = 0; i < terms.size(); i++)
+    {
+        for (int v = 0; v < varCount; v++)
+        {
+            result[v] = std::max(result[v],
+                                 uint64_t(exponentOf(terms[i].monomial, v)));
+        }
+    }
+}
+
+// ------------------------------------checkCompatible--------------------------
+// Description: Throws std::invalid_argument if the two polynomials are not
+//              in the same number of variables.
+// -----------------------------------------------------------------------------
+void MultiPoly::checkCompatible(const MultiPoly &rightObj) const
+{
+    if (varCount != rightObj.varCount)
+    {
+        throw std::invalid_argument("MultiPoly: different variable counts");
+    }
+}
+
+// ------------------------------------combine----------------------------------
+// Description: this = this + sign * rightObj, as a merge of the two sorted
+//              term lists.
+// Features:
+//  - For large inputs, this's terms are cut into one slice per thread and
+//    rightObj's terms are cut at the same monomials, so each thread merges
+//    its own pair of slices and the results only need to be joined.
+// -----------------------------------------------------------------------------
+void MultiPoly::combine(const MultiPoly &rightObj, int sign)
+{
+    checkCompatible(rightObj);
+
+    const std::vector<Term> &left = terms;
+    const std::vector<Term> &right = rightObj.terms;
+    int threadCount = workerCount(left.size() + right.size());
+    std::vector<Term> result;
+
+    if ((threadCount == 1) || left.empty() || right.empty())
+    {
+        result.reserve(left.size() + right.size());
+        mergeTerms(left.data(), left.data() + left.size(),
+                   right.data(), right.data() + right.size(), sign, result);
+        terms.swap(result);
+        return;
+    }
+
+    std::vector<size_t> leftSplit(threadCount + 1);
+    std::vector<size_t> rightSplit(threadCount + 1);
+
+    for (int t = 0; t <= threadCount; t++)
+    {
+        leftSplit[t] = left.size() * t / threadCount;
+
+        if (t == 0)
+        {
+            rightSplit[t] = 0;
+        }
+        else if (t == threadCount)
+        {
+            rightSplit[t] = right.size();
+        }
+        else
+        {
+            rightSplit[t] = std::lower_bound(right.begin(), right.end(),
+                                             left[leftSplit[t]].monomial,
+                                             greaterMonomial) - right.begin();
+        }
+    }
+
+    std::vector<std::vector<Term> > pieces(threadCount);
+
+    runParallel(threadCount, [&](int t)
+    {
+        pieces[t].reserve((leftSplit[t + 1] - leftSplit[t])
+                          + (rightSplit[t + 1] - rightSplit[t]));
+        mergeTerms(left.data() + leftSplit[t], left.data() + leftSplit[t + 1],
+                   right.data() + rightSplit[t],
+                   right.data() + rightSplit[t + 1], sign, pieces[t]);
+    });
+
+    size_t total = 0;
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        total += pieces[t].size();
+    }
+
+    result.reserve(total);
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        result.insert(result.end(), pieces[t].begin(), pieces[t].end());
+    }
+
+    terms.swap(result);
+}
+
+// ------------------------------------multiplySparse---------------------------
+// Description: Every term times every term, with like terms added in a
+//              hash table keyed by the packed monomial.
+// Precondition: No exponent of the product overflows its field.
+// Features:
+//  - With several threads, each thread multiplies a slice of this's terms
+//    by all of rightObj's, and drops each product into one of threadCount
+//    tables picked by a hash of its monomial. Then thread u adds up
+//    everyone's table u, so no two threads ever touch the same monomial.
+//  - Each thread sorts its own terms, and the sorted runs are merged.
+//  - Coefficients are added up as uint64_t, which wraps where long long
+//    could overflow, and cut back to int at the end (see wrapToInt).
+// -----------------------------------------------------------------------------
+void MultiPoly::multiplySparse(const MultiPoly &rightObj,
+                               std::vector<Term> &result) const
+{
+    const std::vector<Term> &left = terms;
+    const std::vector<Term> &right = rightObj.terms;
+    int threadCount = workerCount(left.size() * right.size());
+
+    if (threadCount == 1)
+    {
+        TermTable table;
+
+        for (size_t i = 0; i < left.size(); i++)
+        {
+            for (size_t j = 0; j < right.size(); j++)
+            {
+                table[left[i].monomial + right[j].monomial] +=
+                    uint64_t(left[i].coefficient) * right[j].coefficient;
+            }
+        }
+
+        tableToTerms(table, result);
+        return;
+    }
+
+    // tables[t][u]: products found by thread t that thread u will add up.
+    std::vector<std::vector<TermTable> > tables(threadCount,
+        std::vector<TermTable>(threadCount));
+
+    runParallel(threadCount, [&](int t)
+    {
+        size_t begin = left.size() * t / threadCount;
+        size_t end = left.size() * (t + 1) / threadCount;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            for (size_t j = 0; j < right.size(); j++)
+            {
+                uint64_t monomial = left[i].monomial + right[j].monomial;
+                int owner = ownerOf(monomial, threadCount);
+
+                tables[t][owner][monomial] +=
+                    uint64_t(left[i].coefficient) * right[j].coefficient;
+            }
+        }
+    });
+
+    std::vector<std::vector<Term> > runs(threadCount);
+
+    runParallel(threadCount, [&](int u)
+    {
+        TermTable table;
+        table.swap(tables[0][u]);
+
+        for (int t = 1; t < threadCount; t++)
+        {
+            for (TermTable::const_iterator it = tables[t][u].begin();
+                 it != tables[t][u].end(); ++it)
+            {
+                table[it->first] += it->second;
+            }
+
+            TermTable().swap(tables[t][u]);
+        }
+
+        tableToTerms(table, runs[u]);
+    });
+
+    mergeRuns(runs, result);
+}
+
+// ------------------------------------splitLastVariable------------------------
+// Description: Splits the terms into groups that share the exponents of
+//              every variable but the last. outers gets each group's
+//              monomial with the last exponent 0, and coeffs the group as
+//              a Poly in the last variable.
+// Precondition: varCount is at least 2.
+// -----------------------------------------------------------------------------
+void MultiPoly::splitLastVariable(std::vector<uint64_t> &outers,
+                                  std::vector<Poly> &coeffs) const
+{
+    uint64_t lastMask = (uint64_t(1) << bitsPerVar) - 1;
+    size_t i = 0;
+
+    while (i < terms.size())
+    {
+        uint64_t outer = terms[i].monomial & ~lastMask;
+
+        // Terms are sorted, so the first of a group has its largest power.
+        Poly coeff(0, int(terms[i].monomial & lastMask));
+
+        for (; (i < terms.size()) && ((terms[i].monomial & ~lastMask) == outer);
+             i++)
+        {
+            coeff.setCoeff(terms[i].coefficient,
+                           int(terms[i].monomial & lastMask));
+        }
+
+        outers.push_back(outer);
+        coeffs.push_back(coeff);
+    }
+}
+
+// ------------------------------------multiplyRecursive------------------------
+// Description: The product in recursive form: each side is a polynomial in
+//              the other variables whose coefficients are Polys in the last
+//              variable, and every pair of coefficients is multiplied by
+//              Poly's array multiply.
+// Precondition: As for multiplySparse, and varCount is at least 2.
+// Features:
+//  - Threads split this's coefficients, and hand each product to the
+//    thread that owns its outer monomial, the same way multiplySparse
+//    does with single terms.
+//  - Products are added up as uint64_t, like multiplySparse.
+// -----------------------------------------------------------------------------
+void MultiPoly::multiplyRecursive(const MultiPoly &rightObj,
+                                  std::vector<Term> &result) const
+{
+    std::vector<uint64_t> leftOuters;
+    std::vector<uint64_t> rightOuters;
+    std::vector<Poly> leftCoeffs;
+    std::vector<Poly> rightCoeffs;
+
+    splitLastVariable(leftOuters, leftCoeffs);
+    rightObj.splitLastVariable(rightOuters, rightCoeffs);
+
+    int threadCount = workerCount(terms.size() * rightObj.terms.size());
+    threadCount = std::min(threadCount, int(leftOuters.size()));
+
+    // tables[t][u]: sums found by thread t that thread u will add up.
+    std::vector<std::vector<CoeffTable> > tables(threadCount,
+        std::vector<CoeffTable>(threadCount));
+
+    runParallel(threadCount, [&](int t)
+    {
+        size_t begin = leftOuters.size() * t / threadCount;
+        size_t end = leftOuters.size() * (t + 1) / threadCount;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            for (size_t j = 0; j < rightOuters.size(); j++)
+            {
+                uint64_t outer = leftOuters[i] + rightOuters[j];
+                int owner = ownerOf(outer, threadCount);
+
+                addProduct(tables[t][owner][outer],
+                           leftCoeffs[i] * rightCoeffs[j]);
+            }
+        }
+    });
+
+    std::vector<std::vector<Term> > runs(threadCount);
+
+    runParallel(threadCount, [&](int u)
+    {
+        CoeffTable table;
+        table.swap(tables[0][u]);
+
+        for (int t = 1; t < threadCount; t++)
+        {
+            for (CoeffTable::const_iterator it = tables[t][u].begin();
+                 it != tables[t][u].end(); ++it)
+            {
+                std::vector<uint64_t> &sum = table[it->first];
+
+                if (sum.size() < it->second.size())
+                {
+                    sum.resize(it->second.size(), 0);
+                }
+
+                for (size_t k = 0; k < it->second.size(); k++)
+                {
+                    sum[k] += it->second[k];
+                }
+            }
+
+            CoeffTable().swap(tables[t][u]);
+        }
+
+        for (CoeffTable::const_iterator it = table.begin();
+             it != table.end(); ++it)
+        {
+            for (size_t k = 0; k < it->second.size(); k++)
+            {
+                int coefficient = wrapToInt(it->second[k]);
+
+                if (coefficient != 0)
+                {
+                    Term term = { it->first + k, coefficient };
+                    runs[u].push_back(term);
+                }
+            }
+        }
+
+        std::sort(runs[u].begin(), runs[u].end(), greaterTerm);
+    });
+
+    mergeRuns(runs, result);
+}
+
+// ------------------------------------isDenseUnivariate------------------------
+// Description: True when the polynomial is in one variable and at least
+//              half of the powers up to its degree are present, so Poly's
+//              array is not mostly zeros.
+// -----------------------------------------------------------------------------
+bool MultiPoly::isDenseUnivariate() const
+{
+    if ((varCount != 1) || terms.empty())
+    {
+        return false;
+    }
+
+    return 2 * terms.size() >= terms.front().monomial + 1;
+}
+
+// ------------------------------------isDenseInLastVariable--------------------
+// Description: True when there are at least 2 variables, and split by
+//              splitLastVariable, the Polys would be at least half full
+//              and hold RECURSIVE_GROUP_TERMS terms each on average.
+// -----------------------------------------------------------------------------
+bool MultiPoly::isDenseInLastVariable() const
+{
+    if ((varCount < 2) || terms.empty())
+    {
+        return false;
+    }
+
+    uint64_t lastMask = (uint64_t(1) << bitsPerVar) - 1;
+    size_t groups = 0;
+    uint64_t slots = 0;
+
+    for (size_t i = 0; i < terms.size(); i++)
+    {
+        if ((i == 0) || ((terms[i].monomial & ~lastMask)
+                         != (terms[i - 1].monomial & ~lastMask)))
+        {
+            groups++;
+            slots += (terms[i].monomial & lastMask) + 1;
+        }
+    }
+
+    return (2 * terms.size() >= slots)
+        && (terms.size() >= RECURSIVE_GROUP_TERMS * groups);
+}
+
+// ------------------------------------ operator+ ------------------------------
+// Description: Creates a MultiPoly object and calls operator+=
+// -----------------------------------------------------------------------------
+MultiPoly MultiPoly::operator +(const MultiPoly &rightObj) const
+{
+    MultiPoly result(*this);
+    result += rightObj;
+    return result;
+}
+
+// ------------------------------------ operator- ------------------------------
+// Description: Creates a MultiPoly object and calls operator-=
+// -----------------------------------------------------------------------------
+MultiPoly MultiPoly::operator -(const MultiPoly &rightObj) const
+{
+    MultiPoly result(*this);
+    result -= rightObj;
+    return result;
+}
+
+// ------------------------------------ operator* ------------------------------
+// Description: Multiplies 2 polynomials.
+// Features:
+//  - Throws std::overflow_error, before doing any work, if some variable's
+//    exponent in the product would not fit in its field.
+//  - Dense univariate products are done by Poly's array multiply.
+//  - Multivariate products whose sides are dense in the last variable
+//    are done by multiplyRecursive, which uses Poly for the
+//    coefficients in that variable.
+//  - Everything else goes through multiplySparse.
+// -----------------------------------------------------------------------------
+MultiPoly MultiPoly::operator *(const MultiPoly &rightObj) const
+{
+    checkCompatible(rightObj);
+
+    MultiPoly result(varCount);
+
+    if (terms.empty() || rightObj.terms.empty())
+    {
+        return result;
+    }
+
+    uint64_t leftMax[MAX_VARIABLES];
+    uint64_t rightMax[MAX_VARIABLES];
+
+    maxExponents(leftMax);
+    rightObj.maxExponents(rightMax);
+
+    for (int v = 0; v < varCount; v++)
+    {
+        if (leftMax[v] + rightMax[v] > maxExponent)
+        {
+            throw std::overflow_error("MultiPoly: product exponent too large");
+        }
+    }
+
+    if (isDenseUnivariate() && rightObj.isDenseUnivariate())
+    {
+        Poly product = toPoly();
+        product *= rightObj.toPoly();
+        return MultiPoly(product, 1, 0);
+    }
+
+    if (isDenseInLastVariable() && rightObj.isDenseInLastVariable())
+    {
+        multiplyRecursive(rightObj, result.terms);
+        return result;
+    }
+
+    multiplySparse(rightObj, result.terms);
+
+    return result;
+}
+
+// ------------------------------------ operator+= -----------------------------
+// Description: Adds rightObj to this polynomial.
+// -----------------------------------------------------------------------------
+MultiPoly &MultiPoly::operator +=(const MultiPoly &rightObj)
+{
+    combine(rightObj, 1);
+    return *this;
+}
+
+// ------------------------------------ operator-= -----------------------------
+// Description: Subtracts rightObj from this polynomial.
+// -----------------------------------------------------------------------------
+MultiPoly &MultiPoly::operator -=(const MultiPoly &rightObj)
+{
+    combine(rightObj, -1);
+    return *this;
+}
+
+// ------------------------------------ operator*= -----------------------------
+// Description: Multiplies this polynomial by rightObj, using operator*.
+// -----------------------------------------------------------------------------
+MultiPoly &MultiPoly::operator *=(const MultiPoly &rightObj)
+{
+    *this = *this * rightObj;
+    return *this;
+}
+
+// ------------------------------------ operator== -----------------------------
+// Description: Equal when in the same variables with the same terms.
+// -----------------------------------------------------------------------------
+bool MultiPoly::operator ==(const MultiPoly &rightObj) const
+{
+    if ((varCount != rightObj.varCount)
+        || (terms.size() != rightObj.terms.size()))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < terms.size(); i++)
+    {
+        if ((terms[i].monomial != rightObj.terms[i].monomial)
+            || (terms[i].coefficient != rightObj.terms[i].coefficient))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ------------------------------------ operator!= -----------------------------
+// Description: The opposite of the ==operator.
+// -----------------------------------------------------------------------------
+bool MultiPoly::operator !=(const MultiPoly &rightObj) const
+{
+    return !(*this == rightObj);
+}
+
+// ------------------------------------evaluate---------------------------------
+// Description: Evaluates the polynomial at point (varCount values).
+// Features:
+//  - Powers of each variable are looked up in a table built once, unless
+//    the exponent is too large for a table.
+//  - Large polynomials are summed in one slice per thread.
+// -----------------------------------------------------------------------------
+double MultiPoly::evaluate(const double* point) const
+{
+    uint64_t largest[MAX_VARIABLES];
+    std::vector<std::vector<double> > powers(varCount);
+
+    maxExponents(largest);
+
+    for (int v = 0; v < varCount; v++)
+    {
+        if (largest[v] <= uint64_t(POWER_TABLE_LIMIT))
+        {
+            powers[v].resize(largest[v] + 1);
+            powers[v][0] = 1.0;
+
+            for (size_t e = 1; e <= largest[v]; e++)
+            {
+                powers[v][e] = powers[v][e - 1] * point[v];
+            }
+        }
+    }
+
+    int threadCount = workerCount(terms.size() * varCount);
+    std::vector<double> partialSums(threadCount, 0.0);
+
+    runParallel(threadCount, [&](int t)
+    {
+        size_t begin = terms.size() * t / threadCount;
+        size_t end = terms.size() * (t + 1) / threadCount;
+        double sum = 0.0;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            double value = terms[i].coefficient;
+
+            for (int v = 0; v < varCount; v++)
+            {
+                int exponent = exponentOf(terms[i].monomial, v);
+
+                value *= powers[v].empty()
+                    ? std::pow(point[v], exponent) : powers[v][exponent];
+            }
+
+            sum += value;
+        }
+
+        partialSums[t] = sum;
+    });
+
+    double total = 0.0;
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        total += partialSums[t];
+    }
+
+    return total;
+}
+
+// ------------------------------------getCoeff---------------------------------
+// Description: Returns the coefficient of the monomial with the given
+//              exponents, 0 if there is no such term or an exponent is
+//              out of range.
+// -----------------------------------------------------------------------------
+int MultiPoly::getCoeff(const int* exponents) const
+{
+    for (int v = 0; v < varCount; v++)
+    {
+        if ((exponents[v] < 0) || (uint64_t(exponents[v]) > maxExponent))
+        {
+            return 0;
+        }
+    }
+
+    uint64_t monomial = pack(exponents);
+    std::vector<Term>::const_iterator it =
+        std::lower_bound(terms.begin(), terms.end(), monomial,
+                         greaterMonomial);
+
+    if ((it != terms.end()) && (it->monomial == monomial))
+    {
+        return it->coefficient;
+    }
+
+    return 0;
+}
+
+// ------------------------------------setCoeff---------------------------------
+// Description: Sets the coefficient of the monomial with the given
+//              exponents. Setting it to 0 removes the term.
+//              Returns false and changes nothing if an exponent is negative
+//              or does not fit.
+//              Note: Each call is a sorted insert, to build a large
+//              polynomial add MultiPolys together instead.
+// -----------------------------------------------------------------------------
+bool MultiPoly::setCoeff(int coefficient, const int* exponents)
+{
+    for (int v = 0; v < varCount; v++)
+    {
+        if ((exponents[v] < 0) || (uint64_t(exponents[v]) > maxExponent))
+        {
+            return false;
+        }
+    }
+
+    uint64_t monomial = pack(exponents);
+    std::vector<Term>::iterator it =
+        std::lower_bound(terms.begin(), terms.end(), monomial,
+                         greaterMonomial);
+    bool found = (it != terms.end()) && (it->monomial == monomial);
+
+    if (coefficient == 0)
+    {
+        if (found)
+        {
+            terms.erase(it);
+        }
+    }
+    else if (found)
+    {
+        it->coefficient = coefficient;
+    }
+    else
+    {
+        Term term = { monomial, coefficient };
+        terms.insert(it, term);
+    }
+
+    return true;
+}
+
+// ------------------------------------getVarCount------------------------------
+// Description: Returns the number of variables.
+// -----------------------------------------------------------------------------
+int MultiPoly::getVarCount() const
+{
+    return varCount;
+}
+
+// ------------------------------------getTermCount-----------------------------
+// Description: Returns the number of non-zero terms.
+// -----------------------------------------------------------------------------
+int MultiPoly::getTermCount() const
+{
+    return int(terms.size());
+}
+
+// ------------------------------------getMaxExponent---------------------------
+// Description: Returns the largest exponent any one variable can have.
+// -----------------------------------------------------------------------------
+int MultiPoly::getMaxExponent() const
+{
+    return int(maxExponent);
+}
+
+// ------------------------------------toPoly-----------------------------------
+// Description: Converts a univariate MultiPoly to a dense Poly.
+//              Throws std::invalid_argument if there is more than one
+//              variable.
+// -----------------------------------------------------------------------------
+Poly MultiPoly::toPoly() const
+{
+    if (varCount != 1)
+    {
+        throw std::invalid_argument("MultiPoly: toPoly needs one variable");
+    }
+
+    if (terms.empty())
+    {
+        return Poly();
+    }
+
+    Poly result(0, int(terms.front().monomial));
+
+    for (size_t i = 0; i < terms.size(); i++)
+    {
+        result.setCoeff(terms[i].coefficient, int(terms[i].monomial));
+    }
+
+    return result;
+}
+
+// ----------------------------------- <<operator ------------------------------
+// Description: Outputs the terms from the largest monomial down, with a
+//              space and a sign before each coefficient.
+//              The zero polynomial is " 0".
+// -----------------------------------------------------------------------------
+std::ostream &operator <<(std::ostream &output, const MultiPoly &rightObj)
+{
+    if (rightObj.terms.empty())
+    {
+        output << " 0";
+        return output;
+    }
+
+    for (size_t i = 0; i < rightObj.terms.size(); i++)
+    {
+        const Term &term = rightObj.terms[i];
+
+        output << ' ';
+
+        if (term.coefficient > 0)
+        {
+            output << '+';
+        }
+
+        output << term.coefficient;
+
+        for (int v = 0; v < rightObj.varCount; v++)
+        {
+            int exponent = rightObj.exponentOf(term.monomial, v);
+
+            if (exponent > 0)
+            {
+                output << 'x';
+
+                if (rightObj.varCount > 1)
+                {
+                    output << v;
+                }
+
+                if (exponent > 1)
+                {
+                    output << '^' << exponent;
+                }
+            }
+        }
+    }
+
+    return output;
+}
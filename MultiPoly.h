@@ -0,0 +1,109 @@
+// ------------------------------------------------ MultiPoly.h ----------------
+// Purpose - A sparse polynomial ADT in several variables, for products too
+//              big and too sparse to store densely.
+// -----------------------------------------------------------------------------
+// Assumptions -
+//
+// - Whole number coefficients (int), like Poly.
+// - 1 to MAX_VARIABLES variables, fixed when the object is made. Any other
+//   count throws std::invalid_argument.
+//   Variables are numbered from 0 and printed as x0, x1, ...
+//   (just x for a univariate MultiPoly).
+// - Each exponent fits in 64 / varCount bits. setCoeff refuses larger
+//   ones, and a product that would not fit throws std::overflow_error.
+// - Both sides of an operator have the same varCount, otherwise
+//   std::invalid_argument is thrown.
+//
+// Features -
+//
+// - A monomial's exponents are packed into one 64-bit word, variable 0 in
+//   the highest bits. Multiplying two monomials is adding their words,
+//   and comparing words compares monomials in lexicographic order.
+// - Terms are kept sorted from the largest monomial down, with no zero
+//   coefficients, so add and subtract are a merge.
+// - Multiply accumulates products in hash tables. When both sides are
+//   dense enough in their last variable, they are treated as polynomials
+//   in the other variables with Poly coefficients (recursive form), and
+//   Poly multiplies the coefficients. A dense univariate product is one
+//   Poly multiply.
+// - Add, subtract, multiply and evaluate split large inputs across threads.
+// -----------------------------------------------------------------------------
+
+#ifndef MULTIPOLY_H
+#define MULTIPOLY_H
+
+#include <iostream>
+#include <stdint.h>
+#include <vector>
+
+#include "Poly.h"
+
+class MultiPoly {
+
+    // Console output operator overload
+    friend std::ostream &operator <<(std::ostream &output,
+                                     const MultiPoly &rightObj);
+
+    public:
+        // One non-zero term, coefficient * (the monomial packed in monomial)
+        struct Term {
+            uint64_t monomial;
+            int coefficient;
+        };
+
+        static const int MAX_VARIABLES = 32;
+
+    private:
+        // Number of variables.
+        int varCount;
+        // Bits of the packed word that each exponent gets.
+        int bitsPerVar;
+        // Largest exponent that fits in bitsPerVar bits.
+        uint64_t maxExponent;
+        // Sorted from the largest monomial down, no zero coefficients.
+        std::vector<Term> terms;
+
+        uint64_t pack(const int* exponents) const;
+        int exponentOf(uint64_t monomial, int variable) const;
+        void maxExponents(uint64_t* result) const;
+        void checkCompatible(const MultiPoly &rightObj) const;
+        void combine(const MultiPoly &rightObj, int sign);
+        void multiplySparse(const MultiPoly &rightObj,
+                            std::vector<Term> &result) const;
+        void splitLastVariable(std::vector<uint64_t> &outers,
+                               std::vector<Poly> &coeffs) const;
+        void multiplyRecursive(const MultiPoly &rightObj,
+                               std::vector<Term> &result) const;
+        bool isDenseUnivariate() const;
+        bool isDenseInLastVariable() const;
+
+    public:
+        // Constructors
+        explicit MultiPoly(int varCount = 1);
+        MultiPoly(const Poly& orig, int varCount = 1, int variable = 0);
+
+        // Operator Overloads
+        MultiPoly operator +(const MultiPoly &rightObj) const;
+        MultiPoly operator -(const MultiPoly &rightObj) const;
+        MultiPoly operator *(const MultiPoly &rightObj) const;
+
+        MultiPoly &operator +=(const MultiPoly &rightObj);
+        MultiPoly &operator -=(const MultiPoly &rightObj);
+        MultiPoly &operator *=(const MultiPoly &rightObj);
+
+        bool operator ==(const MultiPoly &rightObj) const;
+        bool operator !=(const MultiPoly &rightObj) const;
+
+        // Evaluation, point has varCount values
+        double evaluate(const double* point) const;
+
+        // Accessors and Mutators, exponents has varCount values
+        int getCoeff(const int* exponents) const;
+        bool setCoeff(int coefficient, const int* exponents);
+        int getVarCount() const;
+        int getTermCount() const;
+        int getMaxExponent() const;
+        Poly toPoly() const;
+};
+
+#endif /* MULTIPOLY_H */
@@ -0,0 +1,900 @@
+// ------------------------------------------------ NumPoly.cpp ----------------
+// Purpose - Implementation of NumPoly<double> and
+//              NumPoly<std::complex<double> >
+// -----------------------------------------------------------------------------
+// Notes -
+//
+// - The template members live here instead of in the header, and the two
+//   supported coefficient types are explicitly instantiated at the bottom.
+// - Build with -pthread, findRootsBatch uses std::thread.
+// -----------------------------------------------------------------------------
+
+#include "NumPoly.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+typedef std::complex<double> Complex;
+
+// Unit roundoff of double.
+static const double UNIT_ROUNDOFF = DBL_EPSILON / 2.0;
+
+// Bound on the relative error of one twiddle factor from fft, in units of
+// UNIT_ROUNDOFF. The angle carries about (2 pi + 1) u from the rounded pi
+// and the multiply by k, and cos and sin add about one more rounding.
+// 8 covers both with room to spare.
+static const double TWIDDLE_ERROR = 8.0 * UNIT_ROUNDOFF;
+
+// findRoots stops moving a root once |p(z)| is below this fraction of
+// (degree + 1) * DBL_EPSILON * sum |c_k| |z|^k, the worst case rounding
+// error of computing p(z) at all. The rounding is usually much smaller
+// than that worst case. At 0.1 a simple root still settles by its
+// correction, as it would without this test, and a cluster of repeated
+// roots reaches it within a few sweeps instead of wandering in the noise.
+static const double ROOT_RESIDUAL = 0.1;
+
+// ------------------------------------toComplex--------------------------------
+// Description: Widens either coefficient type to a complex value so the FFT
+//              and the root finder only need one code path.
+// -----------------------------------------------------------------------------
+static Complex toComplex(double value)
+{
+    return Complex(value, 0.0);
+}
+
+static Complex toComplex(const Complex &value)
+{
+    return value;
+}
+
+// ------------------------------------assignFromComplex------------------------
+// Description: Narrows an FFT output back to the coefficient type. For double
+//              the imaginary part is only rounding noise and is dropped.
+// -----------------------------------------------------------------------------
+static void assignFromComplex(double &dest, const Complex &value)
+{
+    dest = value.real();
+}
+
+static void assignFromComplex(Complex &dest, const Complex &value)
+{
+    dest = value;
+}
+
+// ------------------------------------outputCoeff------------------------------
+// Description: Outputs one coefficient with a leading space and sign,
+//              the same way Poly does it for ints.
+// -----------------------------------------------------------------------------
+static void outputCoeff(std::ostream &output, double value)
+{
+    output << ' ';
+
+    if (value > 0)
+    {
+        output << '+';
+    }
+
+    output << value;
+}
+
+static void outputCoeff(std::ostream &output, const Complex &value)
+{
+    output << " +" << value;
+}
+
+// ------------------------------------fft--------------------------------------
+// Description: In-place iterative radix-2 FFT. size must be a power of 2.
+//              The inverse transform is not scaled by 1/size, the caller
+//              does that.
+//              Twiddle factors are computed directly with std::polar at each
+//              level instead of by repeated multiplication, so their error
+//              does not build up with k. It is still a few roundings (pi,
+//              angle * k, then cos and sin), which multiplyFFT allows for
+//              with TWIDDLE_ERROR.
+// -----------------------------------------------------------------------------
+static void fft(Complex* data, int size, bool inverse)
+{
+    // Bit reversal permutation
+    for (int i = 1, j = 0; i < size; i++)
+    {
+        int bit = size >> 1;
+
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+
+        j ^= bit;
+
+        if (i < j)
+        {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    const double pi = std::acos(-1.0);
+    std::vector<Complex> twiddles(size / 2 > 0 ? size / 2 : 1);
+
+    for (int length = 2; length <= size; length <<= 1)
+    {
+        int half = length / 2;
+        double angle = (inverse ? 2.0 : -2.0) * pi / length;
+
+        for (int k = 0; k < half; k++)
+        {
+            twiddles[k] = std::polar(1.0, angle * k);
+        }
+
+        for (int start = 0; start < size; start += length)
+        {
+            for (int k = 0; k < half; k++)
+            {
+                Complex even = data[start + k];
+                Complex odd = data[start + k + half] * twiddles[k];
+
+                data[start + k] = even + odd;
+                data[start + k + half] = even - odd;
+            }
+        }
+    }
+}
+
+// ------------------------------------grow-------------------------------------
+// Description: Reallocates the array to fit newLargestPower, copies the old
+//              coefficients up to largestPower over and zeroes the rest.
+//              Slots past largestPower may hold stale values from an
+//              earlier operator=, so they are not copied.
+// -----------------------------------------------------------------------------
+template <typename T>
+void NumPoly<T>::grow(int newLargestPower)
+{
+    int newArraySize = newLargestPower + 1;
+    T* newCoeffPtr = new T[newArraySize];
+
+    for (int i = 0; i <= largestPower; i++)
+    {
+        newCoeffPtr[i] = coeffPtr[i];
+    }
+
+    for (int i = largestPower + 1; i < newArraySize; i++)
+    {
+        newCoeffPtr[i] = T();
+    }
+
+    delete[] coeffPtr;
+    coeffPtr = newCoeffPtr;
+
+    arraySize = newArraySize;
+    largestPower = newLargestPower;
+}
+
+// ------------------------------------NumPoly----------------------------------
+// Description: Default Constructor, the zero polynomial.
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T>::NumPoly()
+{
+    largestPower = 0;
+    arraySize = 1;
+
+    coeffPtr = new T[arraySize];
+    coeffPtr[0] = T();
+}
+
+// ------------------------------------NumPoly----------------------------------
+// Description: Constructor for a single term, coefficient * x^power.
+//              A negative power gives the zero polynomial.
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T>::NumPoly(T coefficient, int power)
+{
+    if (power < 0)
+    {
+        coefficient = T();
+        power = 0;
+    }
+
+    largestPower = power;
+    arraySize = power + 1;
+
+    coeffPtr = new T[arraySize];
+
+    for (int i = 0; i < power; i++)
+    {
+        coeffPtr[i] = T();
+    }
+
+    coeffPtr[power] = coefficient;
+}
+
+// ------------------------------------NumPoly----------------------------------
+// Description: Converting Constructor from an int Poly.
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T>::NumPoly(const Poly& orig)
+{
+    largestPower = std::max(orig.getLargestPower(), 0);
+    arraySize = largestPower + 1;
+
+    coeffPtr = new T[arraySize];
+
+    for (int i = 0; i < arraySize; i++)
+    {
+        coeffPtr[i] = T(orig.getCoeff(i));
+    }
+}
+
+// ------------------------------------NumPoly----------------------------------
+// Description: Copy Constructor creates a deep copy.
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T>::NumPoly(const NumPoly& orig)
+{
+    largestPower = orig.largestPower;
+    arraySize = orig.largestPower + 1;
+
+    coeffPtr = new T[arraySize];
+
+    for (int i = 0; i < arraySize; i++)
+    {
+        coeffPtr[i] = orig.coeffPtr[i];
+    }
+}
+
+// ------------------------------------~NumPoly---------------------------------
+// Description: Destructor destroys dynamically allocated array
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T>::~NumPoly()
+{
+    delete[] coeffPtr;
+    coeffPtr = NULL;
+}
+
+// ------------------------------------ operator+ ------------------------------
+// Description: Creates a NumPoly object and calls operator+=
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T> NumPoly<T>::operator +(const NumPoly& rightObj) const
+{
+    NumPoly result(*this);
+    result += rightObj;
+    return result;
+}
+
+// ------------------------------------ operator- ------------------------------
+// Description: Creates a NumPoly object and calls operator-=
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T> NumPoly<T>::operator -(const NumPoly& rightObj) const
+{
+    NumPoly result(*this);
+    result -= rightObj;
+    return result;
+}
+
+// ------------------------------------ operator* ------------------------------
+// Description: Multiplies 2 polynomials.
+// Features:
+//  - Uses the schoolbook loop while either side has fewer than
+//    FFT_THRESHOLD terms, and the FFT above that.
+//  - Callers that need the FFT error bound, or exact schoolbook rounding,
+//    should call multiplyFFT or multiplySchoolbook directly.
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T> NumPoly<T>::operator *(const NumPoly& rightObj) const
+{
+    if (std::min(largestPower, rightObj.largestPower) + 1 < FFT_THRESHOLD)
+    {
+        return multiplySchoolbook(rightObj);
+    }
+
+    double errorBound = 0.0;
+    return multiplyFFT(rightObj, errorBound);
+}
+
+// ------------------------------------ operator= ------------------------------
+// Description: Creates a deep copy of the source NumPoly object. Only
+//              reallocates when the current array is too small.
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T> &NumPoly<T>::operator =(const NumPoly& rightObj)
+{
+    if (this != &rightObj)
+    {
+        if (arraySize < rightObj.largestPower + 1)
+        {
+            delete[] coeffPtr;
+
+            arraySize = rightObj.largestPower + 1;
+            coeffPtr = new T[arraySize];
+        }
+
+        largestPower = rightObj.largestPower;
+
+        for (int i = 0; i <= largestPower; i++)
+        {
+            coeffPtr[i] = rightObj.coeffPtr[i];
+        }
+    }
+
+    return *this;
+}
+
+// ------------------------------------ operator+= -----------------------------
+// Description: Adds rightObj to this polynomial, growing it if needed.
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T> &NumPoly<T>::operator +=(const NumPoly& rightObj)
+{
+    if (arraySize < rightObj.largestPower + 1)
+    {
+        grow(rightObj.largestPower);
+    }
+
+    for (int i = largestPower + 1; i <= rightObj.largestPower; i++)
+    {
+        coeffPtr[i] = T();
+    }
+
+    for (int i = 0; i <= rightObj.largestPower; i++)
+    {
+        coeffPtr[i] += rightObj.coeffPtr[i];
+    }
+
+    largestPower = std::max(largestPower, rightObj.largestPower);
+
+    return *this;
+}
+
+// ------------------------------------ operator-= -----------------------------
+// Description: Subtracts rightObj from this polynomial, growing it if needed.
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T> &NumPoly<T>::operator -=(const NumPoly& rightObj)
+{
+    if (arraySize < rightObj.largestPower + 1)
+    {
+        grow(rightObj.largestPower);
+    }
+
+    for (int i = largestPower + 1; i <= rightObj.largestPower; i++)
+    {
+        coeffPtr[i] = T();
+    }
+
+    for (int i = 0; i <= rightObj.largestPower; i++)
+    {
+        coeffPtr[i] -= rightObj.coeffPtr[i];
+    }
+
+    largestPower = std::max(largestPower, rightObj.largestPower);
+
+    return *this;
+}
+
+// ------------------------------------ operator*= -----------------------------
+// Description: Multiplies this polynomial by rightObj, using operator*.
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T> &NumPoly<T>::operator *=(const NumPoly& rightObj)
+{
+    *this = *this * rightObj;
+    return *this;
+}
+
+// ------------------------------------ operator== -----------------------------
+// Description: Exact comparison of every coefficient. Trailing zero terms
+//              are ignored, so array sizes do not matter.
+//              Note: FFT products are rarely exactly equal to schoolbook
+//              products, compare them against the reported error bound.
+// -----------------------------------------------------------------------------
+template <typename T>
+bool NumPoly<T>::operator ==(const NumPoly &rightObj) const
+{
+    int top = std::max(largestPower, rightObj.largestPower);
+
+    for (int i = 0; i <= top; i++)
+    {
+        if (getCoeff(i) != rightObj.getCoeff(i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ------------------------------------ operator!= -----------------------------
+// Description: The opposite of the ==operator.
+// -----------------------------------------------------------------------------
+template <typename T>
+bool NumPoly<T>::operator !=(const NumPoly &rightObj) const
+{
+    return !(*this == rightObj);
+}
+
+// ------------------------------------multiplySchoolbook-----------------------
+// Description: The O(n*m) product, every term times every term.
+//              Rounding is the same as doing it by hand in order.
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T> NumPoly<T>::multiplySchoolbook(const NumPoly &rightObj) const
+{
+    NumPoly result(T(), largestPower + rightObj.largestPower);
+
+    for (int i = 0; i <= largestPower; i++)
+    {
+        for (int j = 0; j <= rightObj.largestPower; j++)
+        {
+            result.coeffPtr[i + j] += coeffPtr[i] * rightObj.coeffPtr[j];
+        }
+    }
+
+    return result;
+}
+
+// ------------------------------------multiplyFFT------------------------------
+// Description: The O(n log n) product using a complex FFT.
+// Postcondition:
+//  - errorBound is set to an upper bound on the absolute error of any
+//    coefficient of the result, compared to the exact product.
+// Features:
+//  - The bound is Percival's:
+//      ||a||_2 * ||b||_2 * ((1+u)^3L * (1+u*sqrt5)^(3L+1) * (1+b)^3L - 1)
+//    with u the unit roundoff, b the twiddle factor error (TWIDDLE_ERROR)
+//    and L = log2 of the transform size.
+//    It grows with the size of the coefficients, so large integer
+//    coefficients can lose exactness long before the degree is large.
+// -----------------------------------------------------------------------------
+template <typename T>
+NumPoly<T> NumPoly<T>::multiplyFFT(const NumPoly &rightObj,
+                                   double &errorBound) const
+{
+    int resultPower = largestPower + rightObj.largestPower;
+    int size = 1;
+    int levels = 0;
+
+    while (size < resultPower + 1)
+    {
+        size <<= 1;
+        levels++;
+    }
+
+    std::vector<Complex> leftData(size, Complex());
+    std::vector<Complex> rightData(size, Complex());
+    double leftNorm = 0.0;
+    double rightNorm = 0.0;
+
+    for (int i = 0; i <= largestPower; i++)
+    {
+        leftData[i] = toComplex(coeffPtr[i]);
+        leftNorm += std::norm(leftData[i]);
+    }
+
+    for (int i = 0; i <= rightObj.largestPower; i++)
+    {
+        rightData[i] = toComplex(rightObj.coeffPtr[i]);
+        rightNorm += std::norm(rightData[i]);
+    }
+
+    fft(&leftData[0], size, false);
+    fft(&rightData[0], size, false);
+
+    for (int i = 0; i < size; i++)
+    {
+        leftData[i] *= rightData[i];
+    }
+
+    fft(&leftData[0], size, true);
+
+    NumPoly result(T(), resultPower);
+
+    for (int i = 0; i <= resultPower; i++)
+    {
+        assignFromComplex(result.coeffPtr[i], leftData[i] / double(size));
+    }
+
+    double growth = 3.0 * levels * std::log1p(UNIT_ROUNDOFF)
+        + (3.0 * levels + 1.0) * std::log1p(UNIT_ROUNDOFF * std::sqrt(5.0))
+        + 3.0 * levels * std::log1p(TWIDDLE_ERROR);
+
+    errorBound = std::sqrt(leftNorm) * std::sqrt(rightNorm)
+        * std::expm1(growth);
+
+    return result;
+}
+
+// ------------------------------------evaluate---------------------------------
+// Description: Evaluates the polynomial at x with Horner's rule.
+// Features:
+//  - Runs two Horner chains in x^2, one over the even powers and one over
+//    the odd powers, so that the two multiply-adds in each step do not wait
+//    on each other.
+// -----------------------------------------------------------------------------
+template <typename T>
+T NumPoly<T>::evaluate(T x) const
+{
+    T xSquared = x * x;
+    T evenSum = T();
+    T oddSum = T();
+    int i = largestPower;
+
+    if (i % 2 == 0)
+    {
+        evenSum = coeffPtr[i];
+        i--;
+    }
+
+    for (; i >= 1; i -= 2)
+    {
+        oddSum = oddSum * xSquared + coeffPtr[i];
+        evenSum = evenSum * xSquared + coeffPtr[i - 1];
+    }
+
+    return evenSum + x * oddSum;
+}
+
+// ------------------------------------evaluate---------------------------------
+// Description: Evaluates the polynomial at count points, results[k] = p(xs[k]).
+// Precondition: xs and results do not overlap.
+// Features:
+//  - Works through the points EVALUATE_BLOCK at a time. For each block
+//    Horner's rule runs over all the coefficients with the points'
+//    running sums held in a local array, so each step is one pass over
+//    EVALUATE_BLOCK independent points. The points left after the last
+//    full block go through the single point evaluate.
+//  - For double the fixed length pass is what lets g++ vectorize it at
+//    plain -O2 (checked with -fopt-info-vec). A loop over count points
+//    needs a remainder loop, which -O2's cost model will not vectorize.
+//  - The complex pass does not vectorize, because complex multiply goes
+//    through a library call for inf/nan handling (-ffast-math or
+//    -fcx-limited-range inlines it).
+// -----------------------------------------------------------------------------
+template <typename T>
+void NumPoly<T>::evaluate(const T* __restrict xs, T* __restrict results,
+                          int count) const
+{
+    int k = 0;
+
+    for (; k + EVALUATE_BLOCK <= count; k += EVALUATE_BLOCK)
+    {
+        T points[EVALUATE_BLOCK];
+        T sums[EVALUATE_BLOCK];
+
+        for (int lane = 0; lane < EVALUATE_BLOCK; lane++)
+        {
+            points[lane] = xs[k + lane];
+            sums[lane] = coeffPtr[largestPower];
+        }
+
+        for (int i = largestPower - 1; i >= 0; i--)
+        {
+            T coefficient = coeffPtr[i];
+
+            for (int lane = 0; lane < EVALUATE_BLOCK; lane++)
+            {
+                sums[lane] = sums[lane] * points[lane] + coefficient;
+            }
+        }
+
+        for (int lane = 0; lane < EVALUATE_BLOCK; lane++)
+        {
+            results[k + lane] = sums[lane];
+        }
+    }
+
+    for (; k < count; k++)
+    {
+        results[k] = evaluate(xs[k]);
+    }
+}
+
+// ------------------------------------findRoots--------------------------------
+// Description: Finds all complex roots with the Aberth-Ehrlich iteration.
+// Precondition:
+//  - roots has room for getDegree() values.
+// Postcondition:
+//  - rootCount is set to getDegree() and roots holds the approximations.
+//  - Returns true if, within maxIterations, a sweep ends with every root
+//    either moved by less than tolerance (relative to the size of the
+//    root) or stopped because |p(root)| is down to rounding noise (see
+//    ROOT_RESIDUAL).
+//  - true means small residuals, not accurate roots. A simple root is
+//    accurate to about tolerance times its condition number. A root of
+//    multiplicity m is only accurate to about DBL_EPSILON^(1/m) of its
+//    size (about 1e-8 for a double root), because rounding in p hides
+//    where in a cluster that size the roots are.
+// Features:
+//  - Roots at 0 come from the zero low coefficients and are exact. The
+//    iteration only runs on the rest, which is listed first.
+//  - Starts from points spread on a circle of the Fujiwara bound radius.
+//  - Updates each root in place as soon as its correction is known,
+//    which converges in fewer sweeps than updating them all at the end.
+// -----------------------------------------------------------------------------
+template <typename T>
+bool NumPoly<T>::findRoots(Complex* roots, int &rootCount,
+                           int maxIterations, double tolerance) const
+{
+    int degree = getDegree();
+    rootCount = degree;
+
+    if (degree <= 0)
+    {
+        return true;
+    }
+
+    // Each zero coefficient below the lowest non-zero one is a root at
+    // exactly 0. Taking them out keeps the iteration away from repeated
+    // roots at 0, where p(z) is too small for the residual test to stop it.
+    int zeroRoots = 0;
+
+    while (coeffPtr[zeroRoots] == T())
+    {
+        roots[degree - 1 - zeroRoots] = Complex();
+        zeroRoots++;
+    }
+
+    degree -= zeroRoots;
+
+    if (degree == 0)  // x^n, every root is 0
+    {
+        return true;
+    }
+
+    // Work on the monic polynomial.
+    Complex leading = toComplex(coeffPtr[zeroRoots + degree]);
+    std::vector<Complex> monic(degree + 1);
+    std::vector<double> monicSize(degree + 1);
+
+    for (int i = 0; i <= degree; i++)
+    {
+        monic[i] = toComplex(coeffPtr[zeroRoots + i]) / leading;
+        monicSize[i] = std::abs(monic[i]);
+    }
+
+    double radius = 0.0;
+
+    for (int k = 1; k <= degree; k++)
+    {
+        radius = std::max(radius,
+                          std::pow(std::abs(monic[degree - k]), 1.0 / k));
+    }
+
+    radius *= 2.0;
+
+    const double pi = std::acos(-1.0);
+
+    for (int i = 0; i < degree; i++)
+    {
+        roots[i] = std::polar(radius, 2.0 * pi * i / degree + 0.4);
+    }
+
+    for (int iteration = 0; iteration < maxIterations; iteration++)
+    {
+        bool converged = true;
+
+        for (int i = 0; i < degree; i++)
+        {
+            Complex z = roots[i];
+            Complex value = monic[degree];
+            Complex derivative = Complex();
+            double zSize = std::abs(z);
+            double size = monicSize[degree];
+
+            for (int k = degree - 1; k >= 0; k--)
+            {
+                derivative = derivative * z + value;
+                value = value * z + monic[k];
+                size = size * zSize + monicSize[k];
+            }
+
+            // Below this the value is rounding noise, so z is a root of
+            // a polynomial within that much of this one and a correction
+            // would only move it around in the noise.
+            if (std::abs(value)
+                <= ROOT_RESIDUAL * (degree + 1) * DBL_EPSILON * size)
+            {
+                continue;
+            }
+
+            if (value == Complex())
+            {
+                continue;
+            }
+
+            Complex sum = Complex();
+
+            for (int j = 0; j < degree; j++)
+            {
+                if (j != i)
+                {
+                    sum += 1.0 / (z - roots[j]);
+                }
+            }
+
+            Complex denominator = derivative - value * sum;
+
+            if (denominator == Complex())
+            {
+                converged = false;
+                continue;
+            }
+
+            Complex correction = value / denominator;
+            roots[i] = z - correction;
+
+            if (std::abs(correction)
+                > tolerance * std::max(1.0, std::abs(roots[i])))
+            {
+                converged = false;
+            }
+        }
+
+        if (converged)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// ------------------------------------findRootsBatch---------------------------
+// Description: Runs findRoots on polyCount polynomials in parallel.
+// Precondition:
+//  - roots[p] has room for polys[p].getDegree() values.
+//  - rootCounts and converged have polyCount elements.
+// Features:
+//  - Each thread takes every threadCount-th polynomial, so a run of large
+//    polynomials next to each other is still shared between threads.
+//  - threadCount <= 0 uses one thread per hardware thread.
+// -----------------------------------------------------------------------------
+template <typename T>
+void NumPoly<T>::findRootsBatch(const NumPoly* polys, int polyCount,
+                                Complex** roots, int* rootCounts,
+                                bool* converged, int threadCount)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = std::max(1, int(std::thread::hardware_concurrency()));
+    }
+
+    threadCount = std::min(threadCount, polyCount);
+
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        workers.push_back(std::thread([=]()
+        {
+            for (int p = t; p < polyCount; p += threadCount)
+            {
+                converged[p] = polys[p].findRoots(roots[p], rootCounts[p]);
+            }
+        }));
+    }
+
+    for (size_t t = 0; t < workers.size(); t++)
+    {
+        workers[t].join();
+    }
+}
+
+// ------------------------------------getCoeff---------------------------------
+// Description: Returns the coefficient of a given power, 0 if out of range.
+// -----------------------------------------------------------------------------
+template <typename T>
+T NumPoly<T>::getCoeff(int power) const
+{
+    if ((power <= largestPower) && (power >= 0))
+    {
+        return coeffPtr[power];
+    }
+
+    return T();
+}
+
+// ------------------------------------setCoeff---------------------------------
+// Description: Sets the coefficient of a given power, growing if needed.
+//              Returns false and changes nothing for a negative power.
+// -----------------------------------------------------------------------------
+template <typename T>
+bool NumPoly<T>::setCoeff(T coefficient, int power)
+{
+    if (power < 0)
+    {
+        return false;
+    }
+
+    if (arraySize < power + 1)
+    {
+        grow(power);
+    }
+
+    for (int i = largestPower + 1; i < power; i++)
+    {
+        coeffPtr[i] = T();
+    }
+
+    coeffPtr[power] = coefficient;
+    largestPower = std::max(largestPower, power);
+
+    return true;
+}
+
+// ------------------------------------getLargestPower--------------------------
+// Description: Returns the largest power stored, which may have a zero
+//              coefficient.
+// -----------------------------------------------------------------------------
+template <typename T>
+int NumPoly<T>::getLargestPower() const
+{
+    return largestPower;
+}
+
+// ------------------------------------getDegree--------------------------------
+// Description: Returns the largest power with a non-zero coefficient,
+//              0 for the zero polynomial.
+// -----------------------------------------------------------------------------
+template <typename T>
+int NumPoly<T>::getDegree() const
+{
+    for (int i = largestPower; i > 0; i--)
+    {
+        if (coeffPtr[i] != T())
+        {
+            return i;
+        }
+    }
+
+    return 0;
+}
+
+// ----------------------------------- <<operator ------------------------------
+// Description: Outputs the non-zero terms from the largest power down,
+//              in the same format as Poly. The zero polynomial is " 0".
+// -----------------------------------------------------------------------------
+template <typename T>
+std::ostream &operator <<(std::ostream &output, const NumPoly<T> &rightObj)
+{
+    bool anyTerms = false;
+
+    for (int i = rightObj.getLargestPower(); i >= 0; i--)
+    {
+        T coefficient = rightObj.getCoeff(i);
+
+        if (coefficient != T())
+        {
+            outputCoeff(output, coefficient);
+            anyTerms = true;
+
+            if (i > 0)
+            {
+                output << 'x';
+
+                if (i > 1)
+                {
+                    output << '^' << i;
+                }
+            }
+        }
+    }
+
+    if (!anyTerms)
+    {
+        output << " 0";
+    }
+
+    return output;
+}
+
+// The only two coefficient types NumPoly supports.
+template class NumPoly<double>;
+template class NumPoly<Complex>;
+
+template std::ostream &operator <<(std::ostream &, const NumPoly<double> &);
+template std::ostream &operator <<(std::ostream &, const NumPoly<Complex> &);
@@ -0,0 +1,110 @@
+// ------------------------------------------------ NumPoly.h ------------------
+// Purpose - A polynomial ADT with floating-point (double) or complex
+//              (std::complex<double>) coefficients, for numerical work that
+//              the int-only Poly cannot do.
+// -----------------------------------------------------------------------------
+// Assumptions -
+//
+// - T is either double or std::complex<double>. Both are explicitly
+//   instantiated in NumPoly.cpp, so no other T will link.
+// - Products computed with the FFT are only accurate to within the error
+//   bound reported by multiplyFFT.
+// - findRoots returning true means every root has a small residual. A
+//   repeated root is only accurate to about DBL_EPSILON^(1/multiplicity)
+//   of its size, see findRoots in NumPoly.cpp.
+//
+// Features -
+//
+// - Same storage layout as Poly (coeffPtr indexed by power)
+// - Add, subtract and multiply. operator* switches from the schoolbook loop
+//   to an FFT multiply once both sides are large enough for it to pay off.
+// - multiplyFFT reports an error bound so the caller can choose between
+//   speed (FFT) and exact rounding (multiplySchoolbook).
+// - Horner evaluation at a single point, or at many points at once. The
+//   many point version vectorizes for double but not for complex, see
+//   evaluate in NumPoly.cpp.
+// - Aberth root finder, and a batched version that spreads many
+//   polynomials across threads.
+// -----------------------------------------------------------------------------
+
+#ifndef NUMPOLY_H
+#define NUMPOLY_H
+
+#include <complex>
+#include <iostream>
+
+#include "Poly.h"
+
+template <typename T>
+class NumPoly {
+
+    private:
+        // Representing the largest power in the polynomial.
+        int largestPower;
+        // Size of the Array the Polynomial is stored in.
+        // Same growing rules as Poly: it may be larger than needed.
+        int arraySize;
+        // Array pointer representing a polynomial.
+        T* coeffPtr;
+
+        void grow(int newLargestPower);
+
+    public:
+        // Below this many terms (on the smaller side) the schoolbook
+        // multiply is faster than the FFT. Measured at -O2 on two equal
+        // sides: schoolbook wins up to about 384 terms, the two are even
+        // near 448 and the FFT is ahead from 512 up.
+        static const int FFT_THRESHOLD = 512;
+        // Number of points the many point evaluate works on at once.
+        static const int EVALUATE_BLOCK = 8;
+
+        // Constructors
+        NumPoly();
+        NumPoly(T coefficient, int power);
+        NumPoly(const Poly& orig);
+        NumPoly(const NumPoly& orig);
+        virtual ~NumPoly();
+
+        // Operator Overloads
+        NumPoly operator +(const NumPoly &rightObj) const;
+        NumPoly operator -(const NumPoly &rightObj) const;
+        NumPoly operator *(const NumPoly &rightObj) const;
+
+        NumPoly &operator =(const NumPoly &rightObj);
+
+        NumPoly &operator +=(const NumPoly &rightObj);
+        NumPoly &operator -=(const NumPoly &rightObj);
+        NumPoly &operator *=(const NumPoly &rightObj);
+
+        bool operator ==(const NumPoly &rightObj) const;
+        bool operator !=(const NumPoly &rightObj) const;
+
+        // Multiplication
+        NumPoly multiplySchoolbook(const NumPoly &rightObj) const;
+        NumPoly multiplyFFT(const NumPoly &rightObj, double &errorBound) const;
+
+        // Evaluation
+        T evaluate(T x) const;
+        void evaluate(const T* __restrict xs, T* __restrict results,
+                      int count) const;
+
+        // Root finding
+        bool findRoots(std::complex<double>* roots, int &rootCount,
+                       int maxIterations = 500,
+                       double tolerance = 1e-14) const;
+        static void findRootsBatch(const NumPoly* polys, int polyCount,
+                                   std::complex<double>** roots,
+                                   int* rootCounts, bool* converged,
+                                   int threadCount);
+
+        // Accessors and Mutators
+        T getCoeff(int power) const;
+        bool setCoeff(T coefficient, int power);
+        int getLargestPower() const;
+        int getDegree() const;
+};
+
+template <typename T>
+std::ostream &operator <<(std::ostream &output, const NumPoly<T> &rightObj);
+
+#endif /* NUMPOLY_H */
@@ -15,11 +15,20 @@
 // - Can Check for equality
 // - Assignment operator and copy constructor
 // - Uses a dynamically allocated array to hold coefficent
+// - Multiplies larger polynomials a cache sized tile of the result at a
+//   time, with the tile size timed and picked on first use
 // -----------------------------------------------------------------------------
 
 
 #include "Poly.h"
 
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+const int Poly::TILE_SIZE_CANDIDATES[Poly::TILE_SIZE_CANDIDATE_COUNT] =
+    { 32, 64, 128, 256, 512, 1024 };
+
 // ----------------------------------- <<operator ------------------------------
 // Description: Initializes every element to a default 0 value
 // -----------------------------------------------------------------------------
@@ -27,6 +36,8 @@ std::ostream &operator <<(std::ostream &output, const Poly &rightObj)
 {
     output << "";       // Start output with an empty string
     
+    bool anyTerms = false;
+    
     if (rightObj.coeffPtr != NULL)
     {
         // Enumerate through array in reverse order up to largestPower.
@@ -38,6 +49,7 @@ std::ostream &operator <<(std::ostream &output, const Poly &rightObj)
             // Only output coefficient if it is not 0.
             if (rightObj.coeffPtr[i] != 0) 
             {
+                anyTerms = true;
                 
                 // Add a + sign to all positive coefficients,
                 // with a space in front of it.
@@ -68,11 +80,12 @@ std::ostream &operator <<(std::ostream &output, const Poly &rightObj)
             
         }
         
-        // We should output 0, to represent an empty Polynomial.
-        if (rightObj.arraySize == 0) 
-        {
-            output << " 0";
-        }   
+    }
+    
+    // We should output 0, to represent an empty Polynomial.
+    if (!anyTerms)
+    {
+        output << " 0";
     }
     
     return output;      // Return the output
@@ -83,14 +96,18 @@ std::ostream &operator <<(std::ostream &output, const Poly &rightObj)
 // -----------------------------------------------------------------------------
 std::istream &operator >>(std::istream &input, Poly &rightObj)
 {
+    // Start over from the zero polynomial. The old array is freed before
+    // a new one is made, so setCoeff never grows from a deleted pointer.
     if (rightObj.coeffPtr != NULL)
     {
         delete[] rightObj.coeffPtr;
-        rightObj.arraySize = 0;
-        rightObj.largestPower = -1;
-        rightObj.initializeArrayRange(rightObj.coeffPtr, 0, rightObj.arraySize);
     }
     
+    rightObj.arraySize = 1;
+    rightObj.largestPower = 0;
+    rightObj.coeffPtr = rightObj.createNewPoly(rightObj.arraySize);
+    rightObj.initializeArrayRange(rightObj.coeffPtr, 0, rightObj.largestPower);
+    
     
     int coefficient = 0;
     int power = 0;
@@ -108,7 +125,13 @@ std::istream &operator >>(std::istream &input, Poly &rightObj)
         }
         
         
-        rightObj.setCoeff(coefficient, power); 
+        // A negative power is not a term, so stop as if the input were
+        // not a number.
+        if (!rightObj.setCoeff(coefficient, power))
+        {
+            input.setstate(std::ios::failbit);
+            return input;
+        }
         
     }
     
@@ -157,7 +180,8 @@ void Poly::grow(int newLargestPower)
     
     if (coeffPtr != NULL)   // If coeffPtr is NULL, then no elements to copy over.
     {
-        for (int i = 0; i < newLargestPower; i++)
+        // Only arraySize elements exist in the old array.
+        for (int i = 0; i < arraySize; i++)
         {
             newCoeffPtr[i] = coeffPtr[i];
         }
@@ -186,12 +210,13 @@ Poly::Poly()
 }
 
 // ------------------------------------Poly-------------------------------------
-// Description: Constructor with 1 argument
+// Description: Constructor with 1 argument, the constant polynomial
+//              coefficient * x^0
 // -----------------------------------------------------------------------------
 Poly::Poly(int coefficient)
 {
-    arraySize = 2;
-    largestPower = 1;
+    arraySize = 1;
+    largestPower = 0;
     
     coeffPtr = createNewPoly(arraySize);
     coeffPtr[largestPower] = coefficient;
@@ -317,30 +342,31 @@ Poly Poly::operator *(const Poly &rightObj) const
 
 // ------------------------------------ operator= ------------------------------
 // Description: Creates a deep copy of the source Poly object,
-//		but only allocates the the memory needed to store the
-//		current Poly to the largest Power.
-//		I am not entirely sure if this is the best route as far
-//		as efficiency goes, but it makes sense to me to only allocate
-//		for the resources needed, when using the Copy constructor.
+//		but only allocates a new array when the current one is
+//		too small to hold the source up to its largest Power.
+//		Any room left over past the largest Power is set to 0,
+//		so a later setCoeff or += into that room starts from 0.
 // -----------------------------------------------------------------------------
 Poly &Poly::operator =(const Poly& rightObj)
 {
-    if (*this != rightObj)
+    if (this != &rightObj)
     {
         if (arraySize < rightObj.largestPower + 1)
         {
             delete[] coeffPtr;
             
-            largestPower = rightObj.largestPower;
-            arraySize = largestPower + 1;
-            
+            arraySize = rightObj.largestPower + 1;
             coeffPtr = createNewPoly(arraySize);
-            
-            for (int i = 0; i < arraySize; i++)
-            {
-                coeffPtr[i] = rightObj.coeffPtr[i];
-            }
         }
+        
+        largestPower = rightObj.largestPower;
+        
+        for (int i = 0; i <= largestPower; i++)
+        {
+            coeffPtr[i] = rightObj.coeffPtr[i];
+        }
+        
+        initializeArrayRange(coeffPtr, largestPower + 1, arraySize - 1);
     }
     
     return *this;
@@ -374,6 +400,8 @@ Poly &Poly::operator +=(const Poly& rightObj)
             {
                 coeffPtr[i] = rightObj.coeffPtr[i];
             }
+            
+            delete[] tempCoeffPtr;
         }
         else
         {
@@ -390,10 +418,17 @@ Poly &Poly::operator +=(const Poly& rightObj)
     }
     else
     {
-        for (int i = 0; i < rightObj.arraySize; i++)
+        // rightObj may have spare room past its largestPower,
+        // which this array may not have.
+        for (int i = 0; i <= rightObj.largestPower; i++)
         {
             coeffPtr[i] += rightObj.coeffPtr[i];
         }
+        
+        if (largestPower < rightObj.largestPower)
+        {
+            largestPower = rightObj.largestPower;
+        }
     }
     
     return *this;
@@ -420,13 +455,15 @@ Poly &Poly::operator -=(const Poly& rightObj)
             
             for (int i = 0; i < arraySize; i++)
             {
-                coeffPtr[i] = rightObj.coeffPtr[i] - tempCoeffPtr[i];
+                coeffPtr[i] = tempCoeffPtr[i] - rightObj.coeffPtr[i];
             }
             
             for (int i = arraySize; i < newArraySize; i++)
             {
-                coeffPtr[i] = rightObj.coeffPtr[i];
+                coeffPtr[i] = -rightObj.coeffPtr[i];
             }
+            
+            delete[] tempCoeffPtr;
         }
         else
         {
@@ -443,22 +480,32 @@ Poly &Poly::operator -=(const Poly& rightObj)
     }
     else
     {
-        for (int i = 0; i < rightObj.arraySize; i++)
+        // rightObj may have spare room past its largestPower,
+        // which this array may not have.
+        for (int i = 0; i <= rightObj.largestPower; i++)
         {
             coeffPtr[i] -= rightObj.coeffPtr[i];
         }
+        
+        if (largestPower < rightObj.largestPower)
+        {
+            largestPower = rightObj.largestPower;
+        }
     }
 
     return *this;
 }
 
 // ------------------------------------ operator*= -----------------------------
-// Description: Multiplies 2 poly. together and returns Poly reference
+// Description: Multiplies this poly. by rightObj, stores the product in this
+//              poly. and returns a copy of it
 // Precondition:
 //	- Two Poly with at least 1 term
 // Features:
 //	- Creates an Array with the size of the both lengths sumed
 //	- Multipies each term together and places it in the larger array
+//	- Uses tiledProduct when both sides have at least TILED_THRESHOLD
+//	  terms, the plain loop of schoolbookProduct otherwise
 // -----------------------------------------------------------------------------
 Poly Poly::operator *=(const Poly& rightObj)
 {
@@ -474,19 +521,33 @@ Poly Poly::operator *=(const Poly& rightObj)
 	// give us an answer, our question has already changed.
 	// So, there answer to my new question will most likely
 	// be wrong!
-    Poly result(
-        (coeffPtr[largestPower] * rightObj.coeffPtr[rightObj.largestPower]),
-        (largestPower + rightObj.largestPower));
+    // The result starts at all 0, every product (including the two
+    // leading terms) is added in by the loop below exactly once.
+    Poly result(0, (largestPower + rightObj.largestPower));
 
-    for (int i = 0; i <= largestPower; i++)
+    if (std::min(largestPower, rightObj.largestPower) + 1 >= TILED_THRESHOLD)
     {
-        for (int j = 0; j <= rightObj.largestPower; j++)
-        {
-            result.coeffPtr[i + j] += (coeffPtr[i] * rightObj.coeffPtr[j]);
-        }
+        tiledProduct(coeffPtr, largestPower,
+                     rightObj.coeffPtr, rightObj.largestPower,
+                     result.coeffPtr, getTileSize());
+    }
+    else
+    {
+        schoolbookProduct(coeffPtr, largestPower,
+                          rightObj.coeffPtr, rightObj.largestPower,
+                          result.coeffPtr);
     }
 
-    return result;    
+    // Take over the result's array instead of copying it.
+    // result now owns our old array and frees it when it goes away.
+    int* tempCoeffPtr = coeffPtr;
+    coeffPtr = result.coeffPtr;
+    result.coeffPtr = tempCoeffPtr;
+
+    arraySize = result.arraySize;
+    largestPower = result.largestPower;
+
+    return *this;    
 }
 
 // ------------------------------------ operator== -----------------------------
@@ -553,13 +614,13 @@ int Poly::getCoeff(int power) const
 //	- int argument passed in representing the coefficient & exponent
 // Features:
 //	- sets the coefficient in the array of coeffPtr of a given exponent(index)
+//	- returns false, and changes nothing, if power is negative
 // -----------------------------------------------------------------------------
 bool Poly::setCoeff(int coefficient, int power)
 {
     if (power < 0)
     {
-        coefficient = 0;
-        power = 1;
+        return false;
     }
     
     
@@ -571,7 +632,229 @@ bool Poly::setCoeff(int coefficient, int power)
     // Now assign the coefficient coeffPtr[power] element.
     coeffPtr[power] = coefficient;
     
+    // There may have been room for power without it being
+    // the largest power yet.
+    if (largestPower < power)
+    {
+        largestPower = power;
+    }
+    
     return true;
 }
 
+// ------------------------------------getLargestPower--------------------------
+// Description: Accessor that returns the largest power currently stored.
+// Features: Lets other polynomial types walk the coefficients with getCoeff
+//              without knowing about arraySize.
+// -----------------------------------------------------------------------------
+int Poly::getLargestPower() const
+{
+    return largestPower;
+}
+
+// ------------------------------------multiplySchoolbook-----------------------
+// Description: Returns this poly. times rightObj, always with the plain
+//              i/j loop. Kept as the reference the tiled multiply is
+//              checked and timed against.
+// -----------------------------------------------------------------------------
+Poly Poly::multiplySchoolbook(const Poly &rightObj) const
+{
+    Poly result(0, (largestPower + rightObj.largestPower));
+
+    schoolbookProduct(coeffPtr, largestPower,
+                      rightObj.coeffPtr, rightObj.largestPower,
+                      result.coeffPtr);
+
+    return result;
+}
+
+// ------------------------------------multiplyTiled----------------------------
+// Description: Returns this poly. times rightObj, always with tiledProduct
+//              and the given tileSize (for benchmarks and the harness).
+// -----------------------------------------------------------------------------
+Poly Poly::multiplyTiled(const Poly &rightObj, int tileSize) const
+{
+    Poly result(0, (largestPower + rightObj.largestPower));
+
+    tiledProduct(coeffPtr, largestPower,
+                 rightObj.coeffPtr, rightObj.largestPower,
+                 result.coeffPtr, std::max(tileSize, 1));
+
+    return result;
+}
+
+// ------------------------------------getTileSize------------------------------
+// Description: The tile size operator*= uses. Picked by autotuneTileSize
+//              the first time it is needed, and kept from then on.
+// -----------------------------------------------------------------------------
+int Poly::getTileSize()
+{
+    static const int tileSize = autotuneTileSize();
+    return tileSize;
+}
+
+// ------------------------------------schoolbookProduct------------------------
+// Description: Adds every left[i] * right[j] into result[i + j].
+// Precondition: result is all 0.
+// Features:
+//	- The sums are done in unsigned, so a product too large for an int
+//	  wraps, the same as in tiledProduct, instead of being undefined.
+// -----------------------------------------------------------------------------
+void Poly::schoolbookProduct(const int* left, int leftPower,
+                             const int* right, int rightPower, int* result)
+{
+    for (int i = 0; i <= leftPower; i++)
+    {
+        for (int j = 0; j <= rightPower; j++)
+        {
+            result[i + j] = int(unsigned(result[i + j])
+                + unsigned(left[i]) * unsigned(right[j]));
+        }
+    }
+}
+
+// ------------------------------------tiledProduct-----------------------------
+// Description: The same product as schoolbookProduct, computed one tile of
+//              tileSize result coefficients at a time.
+// Features:
+//	- A tile is added up in a buffer of lanes that stays in L1 cache, and
+//	  is written to result once, where the plain loop goes over the whole
+//	  result once for every left[i].
+//	- Within a tile, left is taken tileSize coefficients at a time, so the
+//	  part of right being read also stays in L1.
+//	- Within that, REGISTER_TILE lanes are held in registers while every
+//	  left coefficient of the block is applied to them, so each
+//	  multiply-add is one load of right instead of a load and a store of
+//	  result as well.
+//	- right is copied with tileSize zeros on both sides, so the inner
+//	  loop never needs to check whether right[k - i] exists.
+//	- Lanes are 32-bit unsigned so that overflow wraps exactly like the
+//	  int loop. The result is int, so wider lanes would not change it.
+// -----------------------------------------------------------------------------
+void Poly::tiledProduct(const int* left, int leftPower,
+                        const int* right, int rightPower,
+                        int* result, int tileSize)
+{
+    int resultPower = leftPower + rightPower;
+
+    // A tile never needs to be larger than the result, and the buffers
+    // below are sized by it.
+    tileSize = std::min(tileSize, resultPower + 1);
+
+    // Round tileSize up to whole register tiles.
+    tileSize = ((tileSize + REGISTER_TILE - 1) / REGISTER_TILE)
+        * REGISTER_TILE;
+    std::vector<int> padded(rightPower + 1 + 2 * tileSize, 0);
+    std::vector<unsigned> lanes(tileSize);
+
+    std::copy(right, right + rightPower + 1, padded.begin() + tileSize);
+
+    const int* paddedRight = &padded[tileSize];
+
+    for (int tileStart = 0; tileStart <= resultPower; tileStart += tileSize)
+    {
+        int tileEnd = std::min(tileStart + tileSize, resultPower + 1);
+
+        // Only these left coefficients reach a power in the tile.
+        int firstLeft = std::max(0, tileStart - rightPower);
+        int lastLeft = std::min(leftPower, tileEnd - 1);
+
+        std::fill(lanes.begin(), lanes.end(), 0u);
+
+        for (int blockStart = firstLeft; blockStart <= lastLeft;
+             blockStart += tileSize)
+        {
+            int blockEnd = std::min(blockStart + tileSize - 1, lastLeft);
+
+            for (int laneStart = tileStart; laneStart < tileEnd;
+                 laneStart += REGISTER_TILE)
+            {
+                // Only these left coefficients reach one of these lanes.
+                int iBegin = std::max(blockStart, laneStart - rightPower);
+                int iEnd = std::min(blockEnd, laneStart + REGISTER_TILE - 1);
+                unsigned* lane = &lanes[laneStart - tileStart];
+                unsigned sums[REGISTER_TILE];
+
+                for (int t = 0; t < REGISTER_TILE; t++)
+                {
+                    sums[t] = lane[t];
+                }
+
+                for (int i = iBegin; i <= iEnd; i++)
+                {
+                    unsigned leftCoeff = unsigned(left[i]);
+                    const int* rightAt = paddedRight + (laneStart - i);
+
+                    for (int t = 0; t < REGISTER_TILE; t++)
+                    {
+                        sums[t] += leftCoeff * unsigned(rightAt[t]);
+                    }
+                }
+
+                for (int t = 0; t < REGISTER_TILE; t++)
+                {
+                    lane[t] = sums[t];
+                }
+            }
+        }
+
+        for (int t = 0; t < tileEnd - tileStart; t++)
+        {
+            result[tileStart + t] = int(lanes[t]);
+        }
+    }
+}
+
+// ------------------------------------autotuneTileSize-------------------------
+// Description: Times tiledProduct on a 1024 by 1024 term product for each
+//              size in TILE_SIZE_CANDIDATES, and returns the fastest.
+//              One untimed run first brings the buffers and the code into
+//              cache, so the first candidate is not charged for it.
+//              Takes a few milliseconds, once per run.
+// -----------------------------------------------------------------------------
+int Poly::autotuneTileSize()
+{
+    static const int power = 1023;
+    static const int repeats = 3;
+
+    std::vector<int> left(power + 1);
+    std::vector<int> right(power + 1);
+    std::vector<int> result(2 * power + 1);
+
+    for (int i = 0; i <= power; i++)
+    {
+        left[i] = (i % 7) - 3;
+        right[i] = (i % 5) - 2;
+    }
+
+    tiledProduct(&left[0], power, &right[0], power, &result[0],
+                 TILE_SIZE_CANDIDATES[0]);
+
+    int bestTileSize = TILE_SIZE_CANDIDATES[0];
+    double bestSeconds = 0.0;
+
+    for (int c = 0; c < TILE_SIZE_CANDIDATE_COUNT; c++)
+    {
+        for (int r = 0; r < repeats; r++)
+        {
+            std::chrono::steady_clock::time_point start =
+                std::chrono::steady_clock::now();
+
+            tiledProduct(&left[0], power, &right[0], power, &result[0],
+                         TILE_SIZE_CANDIDATES[c]);
+
+            double seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+
+            if ((bestSeconds == 0.0) || (seconds < bestSeconds))
+            {
+                bestSeconds = seconds;
+                bestTileSize = TILE_SIZE_CANDIDATES[c];
+            }
+        }
+    }
+
+    return bestTileSize;
+}
+
 
@@ -39,7 +39,30 @@ class Poly {
         void initializeArrayRange(int* array, int begin, int end);
         void grow(int newLargestPower);
         
+        // Result lanes tiledProduct keeps in registers at once.
+        static const int REGISTER_TILE = 32;
+        
+        // Multiply kernels, result must have room for
+        // leftPower + rightPower + 1 coefficients.
+        static void schoolbookProduct(const int* left, int leftPower,
+                                      const int* right, int rightPower,
+                                      int* result);
+        static void tiledProduct(const int* left, int leftPower,
+                                 const int* right, int rightPower,
+                                 int* result, int tileSize);
+        static int autotuneTileSize();
+        
     public:
+        // operator*= uses the tiled multiply once both sides have at
+        // least this many terms. Measured at -O2 on two equal sides, the
+        // plain loop wins at 32 terms, they are about even at 48, and the
+        // tiled one is ahead from 64 up.
+        static const int TILED_THRESHOLD = 64;
+        
+        // Tile sizes getTileSize chooses between.
+        static const int TILE_SIZE_CANDIDATE_COUNT = 6;
+        static const int TILE_SIZE_CANDIDATES[TILE_SIZE_CANDIDATE_COUNT];
+        
         // Constructors
         Poly();
         Poly(int coefficient);
@@ -64,10 +87,16 @@ class Poly {
         bool operator ==(const Poly &rightObj) const;
         bool operator !=(const Poly &rightObj) const;
         
+        // Multiplication, operator*= picks one of these
+        Poly multiplySchoolbook(const Poly &rightObj) const;
+        Poly multiplyTiled(const Poly &rightObj, int tileSize) const;
+        static int getTileSize();
+        
         
         // Accessors and Mutators
         int getCoeff(int power) const;
         bool setCoeff(int coefficient, int power);
+        int getLargestPower() const;
         
         
         
@@ -0,0 +1,661 @@
+// ------------------------------------------------ PolyCheck.cpp --------------
+// Purpose - Implementation of PolyCheck
+// -----------------------------------------------------------------------------
+
+#include "PolyCheck.h"
+#include "MultiPoly.h"
+#include "NumPoly.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <complex>
+#include <iomanip>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+typedef std::complex<double> Complex;
+
+// Prime modulus of the modular check, small enough that a product of two
+// residues fits in a long long.
+static const long long CHECK_PRIME = 2147483647LL;
+
+// Number of random points the modular check tries.
+static const int CHECK_POINTS = 3;
+
+// Number of points checkEvaluate tries. Two full blocks of the many point
+// evaluate and a remainder that goes through the single point one.
+static const int EVALUATE_POINTS = 2 * NumPoly<double>::EVALUATE_BLOCK + 3;
+
+// Allowed evaluate error, in units of DBL_EPSILON * (degree + 1) times
+// the sum of |coefficient * x^power|. Horner's rule stays within about 2.
+static const double EVALUATE_ERROR = 8.0;
+
+// Widths of the Kronecker splits for the two variable MultiPolys, where
+// x^i becomes x0^(i / width) * x1^(i % width). The narrow split leaves few
+// terms per power of x0, so its products use the hash tables. The wide
+// one leaves enough for the recursive (Poly coefficient) multiply when
+// the input is dense.
+static const int NARROW_WIDTH = 4;
+static const int WIDE_WIDTH = 64;
+
+// Allowed |p(root)|, in units of DBL_EPSILON * (degree + 1) times the sum
+// of |coefficient| * |root|^power. findRoots stops well inside 1.
+static const double ROOT_ERROR = 1.0;
+
+// ------------------------------------coeffOf----------------------------------
+// Description: The coefficient of x^power in each kind of result, as a
+//              long long so they can all be compared the same way.
+//              A complex coefficient with an imaginary part that does not
+//              round to 0 gives LLONG_MIN, which no int matches.
+//              A MultiPoly here is always in one variable, see
+//              joinKronecker for the two variable ones.
+// -----------------------------------------------------------------------------
+static long long coeffOf(const Poly &poly, int power)
+{
+    return poly.getCoeff(power);
+}
+
+static long long coeffOf(const NumPoly<double> &poly, int power)
+{
+    return std::llround(poly.getCoeff(power));
+}
+
+static long long coeffOf(const NumPoly<Complex> &poly, int power)
+{
+    Complex coefficient = poly.getCoeff(power);
+
+    if (std::fabs(coefficient.imag()) >= 0.5)
+    {
+        return LLONG_MIN;
+    }
+
+    return std::llround(coefficient.real());
+}
+
+static long long coeffOf(const MultiPoly &poly, int power)
+{
+    return poly.getCoeff(&power);
+}
+
+// ------------------------------------compare----------------------------------
+// Description: Compares actual against the reference up to largestPower.
+//              Reports the first different coefficient to errors.
+// -----------------------------------------------------------------------------
+template <typename Result>
+static bool compare(const char* what, const Poly &expected,
+                    const Result &actual, int largestPower,
+                    std::ostream &errors)
+{
+    for (int i = 0; i <= largestPower; i++)
+    {
+        if (coeffOf(expected, i) != coeffOf(actual, i))
+        {
+            errors << what << ": x^" << i << " expected "
+                   << coeffOf(expected, i) << " got " << coeffOf(actual, i)
+                   << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ------------------------------------splitKronecker---------------------------
+// Description: poly as a MultiPoly in x0 and x1, with x^i written as
+//              x0^(i / width) * x1^(i % width).
+// -----------------------------------------------------------------------------
+static MultiPoly splitKronecker(const Poly &poly, int width)
+{
+    MultiPoly result(2);
+    int exponents[2];
+
+    // From the largest power down appends each term at the end.
+    for (int i = poly.getLargestPower(); i >= 0; i--)
+    {
+        if (poly.getCoeff(i) != 0)
+        {
+            exponents[0] = i / width;
+            exponents[1] = i % width;
+            result.setCoeff(poly.getCoeff(i), exponents);
+        }
+    }
+
+    return result;
+}
+
+// ------------------------------------joinKronecker----------------------------
+// Description: Undoes splitKronecker for a sum or product of split
+//              polynomials, up to largestPower. In a product the power of
+//              x1 can reach 2 * width - 2, so x^i gathers the terms
+//              x0^q * x1^(i - q * width) for q = i / width - 1 and i / width.
+// -----------------------------------------------------------------------------
+static Poly joinKronecker(const MultiPoly &poly, int width, int largestPower)
+{
+    Poly result;
+
+    for (int i = 0; i <= largestPower; i++)
+    {
+        int coefficient = 0;
+
+        for (int q = i / width - 1; q <= i / width; q++)
+        {
+            int exponents[2] = { q, i - q * width };
+            coefficient += poly.getCoeff(exponents);
+        }
+
+        result.setCoeff(coefficient, i);
+    }
+
+    return result;
+}
+
+// ------------------------------------evaluateReference------------------------
+// Description: poly at x by Horner's rule in long double, for a real or
+//              complex x. size is set to the sum of |coefficient * x^power|,
+//              which the error of evaluating in double is relative to.
+// -----------------------------------------------------------------------------
+template <typename Number>
+static Number evaluateReference(const Poly &poly, const Number &x,
+                                long double &size)
+{
+    Number result = Number(0);
+    long double magnitude = std::abs(x);
+
+    size = 0.0L;
+
+    for (int i = poly.getLargestPower(); i >= 0; i--)
+    {
+        result = result * x + Number(poly.getCoeff(i));
+        size = size * magnitude + std::abs(poly.getCoeff(i));
+    }
+
+    return result;
+}
+
+// ------------------------------------closeTo----------------------------------
+// Description: True if difference is within tolerance, otherwise reports
+//              what was evaluated at x to errors.
+// -----------------------------------------------------------------------------
+template <typename Point>
+static bool closeTo(const char* what, const Point &x, long double difference,
+                    long double tolerance, std::ostream &errors)
+{
+    if (difference <= tolerance)
+    {
+        return true;
+    }
+
+    errors << what << ": at x = " << x << " off by " << double(difference)
+           << ", allowed " << double(tolerance) << std::endl;
+    return false;
+}
+
+// ------------------------------------evaluateModulo---------------------------
+// Description: Evaluates poly at x modulo CHECK_PRIME with Horner's rule.
+// -----------------------------------------------------------------------------
+static long long evaluateModulo(const Poly &poly, long long x)
+{
+    long long result = 0;
+
+    for (int i = poly.getLargestPower(); i >= 0; i--)
+    {
+        long long coefficient = poly.getCoeff(i) % CHECK_PRIME;
+        result = (result * x + coefficient + CHECK_PRIME) % CHECK_PRIME;
+    }
+
+    return result;
+}
+
+// ------------------------------------secondsSince-----------------------------
+// Description: Seconds passed since start.
+// -----------------------------------------------------------------------------
+static double secondsSince(const Clock::time_point &start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// ------------------------------------PolyCheck--------------------------------
+// Description: Constructor. seed fixes the random points of the modular
+//              check, so a failing run can be repeated.
+// -----------------------------------------------------------------------------
+PolyCheck::PolyCheck(double quadraticWork, unsigned long long seed)
+    : quadraticWork(quadraticWork), random(seed)
+{
+    // Autotune now, so it is not timed as part of the first multiply.
+    Poly::getTileSize();
+    resetTimes();
+}
+
+// ------------------------------------checkModular-----------------------------
+// Description: Checks product == a * b by evaluating both sides at random
+//              points modulo a prime. A wrong product passes one point
+//              with chance at most productPower / CHECK_PRIME.
+// -----------------------------------------------------------------------------
+bool PolyCheck::checkModular(const Poly &a, const Poly &b,
+                             const long long* product, int productPower,
+                             std::ostream &errors)
+{
+    std::uniform_int_distribution<long long> pick(2, CHECK_PRIME - 1);
+
+    for (int k = 0; k < CHECK_POINTS; k++)
+    {
+        long long x = pick(random);
+        long long expected = evaluateModulo(a, x) * evaluateModulo(b, x)
+            % CHECK_PRIME;
+        long long actual = 0;
+
+        for (int i = productPower; i >= 0; i--)
+        {
+            actual = (actual * x + product[i] % CHECK_PRIME + CHECK_PRIME)
+                % CHECK_PRIME;
+        }
+
+        if (actual != expected)
+        {
+            errors << pathName(NUMPOLY_FFT) << " *: a(x) * b(x) != c(x) mod "
+                   << CHECK_PRIME << " at x = " << x << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ------------------------------------checkEvaluate----------------------------
+// Description: Evaluates poly at EVALUATE_POINTS random points with
+//              NumPoly's many point evaluate (double and complex) and with
+//              MultiPoly's (one variable, and split in two), and checks
+//              each against Horner's rule on poly in long double.
+//              Real points are in [-1, 1] and complex ones in the unit
+//              disk, so the values stay in range at any degree.
+// -----------------------------------------------------------------------------
+bool PolyCheck::checkEvaluate(const Poly &poly, std::ostream &errors)
+{
+    NumPoly<double> realPoly(poly);
+    NumPoly<Complex> complexPoly(poly);
+    MultiPoly onePoly(poly);
+    MultiPoly twoPoly = splitKronecker(poly, NARROW_WIDTH);
+    std::uniform_real_distribution<double> pick(-1.0, 1.0);
+    double xs[EVALUATE_POINTS];
+    double realResults[EVALUATE_POINTS];
+    Complex zs[EVALUATE_POINTS];
+    Complex complexResults[EVALUATE_POINTS];
+    bool matched = true;
+
+    for (int k = 0; k < EVALUATE_POINTS; k++)
+    {
+        xs[k] = pick(random);
+        zs[k] = Complex(pick(random), pick(random)) / std::sqrt(2.0);
+    }
+
+    realPoly.evaluate(xs, realResults, EVALUATE_POINTS);
+    complexPoly.evaluate(zs, complexResults, EVALUATE_POINTS);
+
+    double scale = EVALUATE_ERROR * DBL_EPSILON * (poly.getLargestPower() + 1);
+
+    for (int k = 0; (k < EVALUATE_POINTS) && matched; k++)
+    {
+        long double size = 0.0L;
+        long double x = xs[k];
+        long double expected = evaluateReference(poly, x, size);
+        double twoPoint[2] = { std::pow(xs[k], NARROW_WIDTH), xs[k] };
+
+        matched = closeTo("NumPoly evaluate", xs[k],
+                          std::fabs(realResults[k] - expected),
+                          scale * size, errors)
+            && closeTo("MultiPoly evaluate", xs[k],
+                       std::fabs(onePoly.evaluate(&xs[k]) - expected),
+                       scale * size, errors)
+            && closeTo("MultiPoly 2 vars evaluate", xs[k],
+                       std::fabs(twoPoly.evaluate(twoPoint) - expected),
+                       scale * size, errors);
+
+        std::complex<long double> z(zs[k].real(), zs[k].imag());
+        std::complex<long double> complexExpected =
+            evaluateReference(poly, z, size);
+        std::complex<long double> complexResult(complexResults[k].real(),
+                                                complexResults[k].imag());
+
+        matched = matched
+            && closeTo("NumPoly complex evaluate", zs[k],
+                       std::abs(complexResult - complexExpected),
+                       scale * size, errors);
+    }
+
+    return matched;
+}
+
+// ------------------------------------checkRoots-------------------------------
+// Description: Finds the roots of polyCount polynomials with
+//              NumPoly::findRootsBatch, and checks that each polynomial
+//              converged, that Horner's rule on the Poly in long double
+//              gives a small residual at every root, and that findRoots on
+//              that polynomial alone gives the same roots.
+//              Counts each polynomial that fails as a failure.
+// -----------------------------------------------------------------------------
+bool PolyCheck::checkRoots(const Poly* polys, int polyCount,
+                           std::ostream &errors)
+{
+    std::vector<NumPoly<double> > numPolys(polys, polys + polyCount);
+    std::vector<std::vector<Complex> > batchRoots(polyCount);
+    std::vector<Complex*> rootPtrs(polyCount);
+    std::vector<int> rootCounts(polyCount);
+    bool* converged = new bool[polyCount];
+    bool allMatched = true;
+
+    for (int p = 0; p < polyCount; p++)
+    {
+        batchRoots[p].resize(std::max(numPolys[p].getDegree(), 1));
+        rootPtrs[p] = &batchRoots[p][0];
+    }
+
+    NumPoly<double>::findRootsBatch(&numPolys[0], polyCount, &rootPtrs[0],
+                                    &rootCounts[0], converged, 0);
+
+    for (int p = 0; p < polyCount; p++)
+    {
+        std::vector<Complex> roots(batchRoots[p].size());
+        int rootCount = 0;
+        bool alone = numPolys[p].findRoots(&roots[0], rootCount);
+        bool matched = true;
+
+        if (!converged[p])
+        {
+            errors << "NumPoly findRootsBatch: did not converge" << std::endl;
+            matched = false;
+        }
+
+        if ((alone != converged[p]) || (rootCount != rootCounts[p])
+            || !std::equal(roots.begin(), roots.begin() + rootCount,
+                           batchRoots[p].begin()))
+        {
+            errors << "NumPoly findRootsBatch: differs from findRoots"
+                   << std::endl;
+            matched = false;
+        }
+
+        double scale = ROOT_ERROR * DBL_EPSILON * (rootCount + 1);
+
+        for (int k = 0; (k < rootCount) && matched; k++)
+        {
+            long double size = 0.0L;
+            std::complex<long double> z(batchRoots[p][k].real(),
+                                        batchRoots[p][k].imag());
+            long double residual = std::abs(evaluateReference(polys[p], z,
+                                                              size));
+
+            matched = closeTo("NumPoly findRoots |p(root)|",
+                              batchRoots[p][k], residual, scale * size,
+                              errors);
+        }
+
+        if (!matched)
+        {
+            errors << "P =" << polys[p] << std::endl;
+            failures++;
+            allMatched = false;
+        }
+    }
+
+    delete[] converged;
+
+    return allMatched;
+}
+
+// ------------------------------------check------------------------------------
+// Description: Runs a + b, a - b and a * b through every path and compares
+//              them with Poly's, and checks every evaluate on a and b.
+//              Returns false, and writes what differed to errors, if any
+//              path disagrees.
+// -----------------------------------------------------------------------------
+bool PolyCheck::check(const Poly &a, const Poly &b, std::ostream &errors)
+{
+    int aPower = a.getLargestPower();
+    int bPower = b.getLargestPower();
+    int sumPower = std::max(aPower, bPower);
+    int productPower = aPower + bPower;
+    bool runQuadratic = double(aPower + 1) * (bPower + 1) <= quadraticWork;
+    bool matched = true;
+
+    pairs++;
+
+    NumPoly<double> numA(a);
+    NumPoly<double> numB(b);
+    NumPoly<Complex> complexA(a);
+    NumPoly<Complex> complexB(b);
+    MultiPoly oneA(a);
+    MultiPoly oneB(b);
+    MultiPoly twoA = splitKronecker(a, NARROW_WIDTH);
+    MultiPoly twoB = splitKronecker(b, NARROW_WIDTH);
+
+    // Add, subtract and evaluate are linear, so they are always checked.
+    Poly sum = a + b;
+    Poly difference = a - b;
+
+    matched = compare("NumPoly +", sum, numA + numB, sumPower, errors)
+        && compare("NumPoly -", difference, numA - numB, sumPower, errors)
+        && compare("NumPoly complex +", sum, complexA + complexB, sumPower,
+                   errors)
+        && compare("NumPoly complex -", difference, complexA - complexB,
+                   sumPower, errors)
+        && compare("MultiPoly +", sum, oneA + oneB, sumPower, errors)
+        && compare("MultiPoly -", difference, oneA - oneB, sumPower, errors)
+        && compare("MultiPoly 2 vars +", sum,
+                   joinKronecker(twoA + twoB, NARROW_WIDTH, sumPower),
+                   sumPower, errors)
+        && compare("MultiPoly 2 vars -", difference,
+                   joinKronecker(twoA - twoB, NARROW_WIDTH, sumPower),
+                   sumPower, errors)
+        && checkEvaluate(a, errors)
+        && checkEvaluate(b, errors)
+        && matched;
+
+    // The FFT runs at every size.
+    Clock::time_point start = Clock::now();
+    double errorBound = 0.0;
+    NumPoly<double> fftProduct = numA.multiplyFFT(numB, errorBound);
+    seconds[NUMPOLY_FFT] += secondsSince(start);
+    runs[NUMPOLY_FFT]++;
+
+    if (errorBound >= 0.5)
+    {
+        errors << pathName(NUMPOLY_FFT) << " *: error bound " << errorBound
+               << " is too large to round to exact ints" << std::endl;
+        matched = false;
+    }
+
+    if (!runQuadratic)
+    {
+        std::vector<long long> fftCoeffs(productPower + 1);
+
+        for (int i = 0; i <= productPower; i++)
+        {
+            fftCoeffs[i] = coeffOf(fftProduct, i);
+        }
+
+        matched = checkModular(a, b, &fftCoeffs[0], productPower, errors)
+            && matched;
+
+        if (!matched)
+        {
+            failures++;
+        }
+
+        return matched;
+    }
+
+    start = Clock::now();
+    Poly product = a.multiplySchoolbook(b);
+    seconds[REFERENCE] += secondsSince(start);
+    runs[REFERENCE]++;
+
+    start = Clock::now();
+    Poly operatorProduct = a * b;
+    seconds[POLY_OPERATOR] += secondsSince(start);
+    runs[POLY_OPERATOR]++;
+
+    matched = compare(pathName(POLY_OPERATOR), product, operatorProduct,
+                      productPower, errors) && matched;
+
+    start = Clock::now();
+    Poly tiledProduct = a.multiplyTiled(b, Poly::getTileSize());
+    seconds[POLY_TILED] += secondsSince(start);
+    runs[POLY_TILED]++;
+
+    matched = compare(pathName(POLY_TILED), product, tiledProduct,
+                      productPower, errors) && matched;
+
+    matched = compare(pathName(NUMPOLY_FFT), product, fftProduct,
+                      productPower, errors) && matched;
+
+    start = Clock::now();
+    NumPoly<double> schoolbookProduct = numA.multiplySchoolbook(numB);
+    seconds[NUMPOLY_SCHOOLBOOK] += secondsSince(start);
+    runs[NUMPOLY_SCHOOLBOOK]++;
+
+    matched = compare(pathName(NUMPOLY_SCHOOLBOOK), product,
+                      schoolbookProduct, productPower, errors) && matched;
+
+    start = Clock::now();
+    double complexErrorBound = 0.0;
+    NumPoly<Complex> complexProduct =
+        complexA.multiplyFFT(complexB, complexErrorBound);
+    seconds[NUMPOLY_COMPLEX_FFT] += secondsSince(start);
+    runs[NUMPOLY_COMPLEX_FFT]++;
+
+    matched = compare(pathName(NUMPOLY_COMPLEX_FFT), product, complexProduct,
+                      productPower, errors) && matched;
+
+    start = Clock::now();
+    MultiPoly oneProduct = oneA * oneB;
+    seconds[MULTIPOLY_ONE_VAR] += secondsSince(start);
+    runs[MULTIPOLY_ONE_VAR]++;
+
+    matched = compare(pathName(MULTIPOLY_ONE_VAR), product, oneProduct,
+                      productPower, errors) && matched;
+
+    start = Clock::now();
+    MultiPoly twoProduct = twoA * twoB;
+    seconds[MULTIPOLY_TWO_VARS] += secondsSince(start);
+    runs[MULTIPOLY_TWO_VARS]++;
+
+    matched = compare(pathName(MULTIPOLY_TWO_VARS), product,
+                      joinKronecker(twoProduct, NARROW_WIDTH, productPower),
+                      productPower, errors) && matched;
+
+    MultiPoly wideA = splitKronecker(a, WIDE_WIDTH);
+    MultiPoly wideB = splitKronecker(b, WIDE_WIDTH);
+
+    start = Clock::now();
+    MultiPoly wideProduct = wideA * wideB;
+    seconds[MULTIPOLY_TWO_VARS_WIDE] += secondsSince(start);
+    runs[MULTIPOLY_TWO_VARS_WIDE]++;
+
+    matched = compare(pathName(MULTIPOLY_TWO_VARS_WIDE), product,
+                      joinKronecker(wideProduct, WIDE_WIDTH, productPower),
+                      productPower, errors) && matched;
+
+    if (!matched)
+    {
+        failures++;
+    }
+
+    return matched;
+}
+
+// ------------------------------------pathName---------------------------------
+// Description: Name of a Path for reports.
+// -----------------------------------------------------------------------------
+const char* PolyCheck::pathName(int path)
+{
+    switch (path)
+    {
+        case REFERENCE:
+            return "Poly schoolbook * (ref)";
+        case POLY_OPERATOR:
+            return "Poly operator *";
+        case POLY_TILED:
+            return "Poly tiled *";
+        case NUMPOLY_SCHOOLBOOK:
+            return "NumPoly schoolbook *";
+        case NUMPOLY_FFT:
+            return "NumPoly FFT *";
+        case NUMPOLY_COMPLEX_FFT:
+            return "NumPoly complex FFT *";
+        case MULTIPOLY_ONE_VAR:
+            return "MultiPoly 1 var *";
+        case MULTIPOLY_TWO_VARS:
+            return "MultiPoly 2 vars *";
+        case MULTIPOLY_TWO_VARS_WIDE:
+            return "MultiPoly 2 vars wide *";
+        default:
+            return "?";
+    }
+}
+
+// ------------------------------------printTimes-------------------------------
+// Description: Outputs a table of how long each path's multiplies took,
+//              and how that compares to the reference over the same pairs.
+//              Only pairs small enough for the reference count toward the
+//              comparison, the FFT column may include larger ones.
+// -----------------------------------------------------------------------------
+void PolyCheck::printTimes(std::ostream &output) const
+{
+    output << std::left << std::setw(24) << "path"
+           << std::right << std::setw(8) << "runs"
+           << std::setw(14) << "seconds"
+           << std::setw(14) << "vs reference" << std::endl;
+
+    for (int path = 0; path < PATH_COUNT; path++)
+    {
+        output << std::left << std::setw(24) << pathName(path)
+               << std::right << std::setw(8) << runs[path]
+               << std::setw(14) << std::fixed << std::setprecision(6)
+               << seconds[path];
+
+        if ((runs[path] == runs[REFERENCE]) && (seconds[path] > 0.0))
+        {
+            output << std::setw(13) << std::setprecision(2)
+                   << seconds[REFERENCE] / seconds[path] << 'x';
+        }
+
+        output << std::endl;
+    }
+
+    output.unsetf(std::ios::fixed);
+    output << std::setprecision(6);
+}
+
+// ------------------------------------resetTimes-------------------------------
+// Description: Clears the times and the pair and failure counts.
+// -----------------------------------------------------------------------------
+void PolyCheck::resetTimes()
+{
+    for (int path = 0; path < PATH_COUNT; path++)
+    {
+        seconds[path] = 0.0;
+        runs[path] = 0;
+    }
+
+    pairs = 0;
+    failures = 0;
+}
+
+// ------------------------------------getPairs---------------------------------
+// Description: Number of pairs checked since the last resetTimes.
+// -----------------------------------------------------------------------------
+long PolyCheck::getPairs() const
+{
+    return pairs;
+}
+
+// ------------------------------------getFailures------------------------------
+// Description: Number of those pairs where some path did not match.
+// -----------------------------------------------------------------------------
+long PolyCheck::getFailures() const
+{
+    return failures;
+}
@@ -0,0 +1,97 @@
+// ------------------------------------------------ PolyCheck.h ----------------
+// Purpose - Differential checks of the fast polynomial code (NumPoly,
+//              MultiPoly) against Poly, which is kept as the reference.
+// -----------------------------------------------------------------------------
+// Assumptions -
+//
+// - Coefficients are small enough that Poly's int products do not
+//   overflow, since the reference is only correct then.
+//
+// Features -
+//
+// - check runs every path on one pair and compares each against Poly's
+//   +, - and multiplySchoolbook (the original i/j loop). Each path's
+//   multiply is timed, so one run reports both drift and slowdowns.
+// - Poly's own operator* is one of the paths, so the dispatch between
+//   its kernels is checked as well as the tiled kernel on its own.
+// - The O(n*m) paths, the reference included, only run while the product
+//   needs at most quadraticWork coefficient multiplies. Past that, the FFT
+//   product is checked with a(x) * b(x) == c(x) mod a prime at random x
+//   instead of against the reference.
+// - The FFT path also fails when its error bound reaches 0.5, since its
+//   product can no longer be trusted to round to the exact ints.
+// - Evaluate is checked on both inputs of every pair: NumPoly's many
+//   point evaluate for double and complex (enough points for whole blocks
+//   and a remainder) and MultiPoly's, against Horner's rule on the Poly in
+//   long double.
+// - The two variable MultiPolys split x^i as x0^(i / width) *
+//   x1^(i % width) (Kronecker), so products mix both variables. A narrow
+//   split exercises the hash table multiply and a wide one the recursive
+//   (Poly coefficient) multiply.
+// - checkRoots runs the batched root finder on many polynomials and checks
+//   each residual |p(root)| on the Poly in long double, and that the batch
+//   gives the same roots as one polynomial at a time.
+// - Used by polyfuzz.cpp (libFuzzer) and polystress.cpp (stress runner).
+// -----------------------------------------------------------------------------
+
+#ifndef POLYCHECK_H
+#define POLYCHECK_H
+
+#include <iostream>
+#include <random>
+
+#include "Poly.h"
+
+class PolyCheck {
+
+    public:
+        // Every multiply path that check times.
+        enum Path {
+            REFERENCE,
+            POLY_OPERATOR,
+            POLY_TILED,
+            NUMPOLY_SCHOOLBOOK,
+            NUMPOLY_FFT,
+            NUMPOLY_COMPLEX_FFT,
+            MULTIPOLY_ONE_VAR,
+            MULTIPOLY_TWO_VARS,
+            MULTIPOLY_TWO_VARS_WIDE,
+            PATH_COUNT
+        };
+
+    private:
+        // Largest (a terms) * (b terms) the O(n*m) paths are run for.
+        double quadraticWork;
+        // Source of the random points for the modular check.
+        std::mt19937_64 random;
+        // Time spent in, and number of runs of, each path's multiply.
+        double seconds[PATH_COUNT];
+        long runs[PATH_COUNT];
+        // Number of pairs checked, and how many did not match.
+        long pairs;
+        long failures;
+
+        bool checkModular(const Poly &a, const Poly &b,
+                          const long long* product, int productPower,
+                          std::ostream &errors);
+        bool checkEvaluate(const Poly &poly, std::ostream &errors);
+
+    public:
+        // Constructors
+        explicit PolyCheck(double quadraticWork = 2e8,
+                           unsigned long long seed = 1);
+
+        // Checking
+        bool check(const Poly &a, const Poly &b, std::ostream &errors);
+        bool checkRoots(const Poly* polys, int polyCount,
+                        std::ostream &errors);
+
+        // Report
+        static const char* pathName(int path);
+        void printTimes(std::ostream &output) const;
+        void resetTimes();
+        long getPairs() const;
+        long getFailures() const;
+};
+
+#endif /* POLYCHECK_H */
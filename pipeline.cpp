@@ -0,0 +1,203 @@
+// ------------------------------------------------ pipeline.cpp ---------------
+// Purpose - A driver for processing a stream of many A/B polynomial pairs,
+//              where main.cpp only handles one.
+// -----------------------------------------------------------------------------
+// Usage -
+//
+//   g++ -std=c++11 -pthread pipeline.cpp Poly.cpp -o pipeline
+//   ./pipeline [queueCapacity] < pairs.txt
+//
+// Input is the same as main.cpp's, repeated: the terms of A ended by -1 -1,
+// then the terms of B ended by -1 -1, then the next pair. Input may only
+// end between pairs. A pair that is cut off by the end of input, or that
+// holds something other than a number or a negative power, stops the run:
+// the pairs before it are still printed, then the bad pair's number goes
+// to std::cerr and the exit status is 1.
+//
+// Features -
+//
+// - Four stages, each on its own thread, connected by BoundedQueues:
+//     read (operator>>) -> compute (+, -, *) -> format (operator<<) -> write
+//   so reading the next pair overlaps computing and printing earlier ones.
+// - Every queue holds at most queueCapacity pairs (default 64), so a stage
+//   that falls behind makes the ones before it wait instead of buffering
+//   the whole input in memory.
+// - One thread per stage keeps the output in input order.
+// -----------------------------------------------------------------------------
+
+#include "Poly.h"
+#include "BoundedQueue.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// One A/B pair as it comes off the input.
+struct PolyPair {
+    long number;
+    Poly a;
+    Poly b;
+};
+
+// The pair plus everything computed from it.
+struct PairResult {
+    long number;
+    Poly a;
+    Poly b;
+    Poly sum;
+    Poly difference;
+    Poly product;
+
+    PairResult(const PolyPair &pair)
+        : number(pair.number), a(pair.a), b(pair.b),
+          sum(pair.a + pair.b), difference(pair.a - pair.b),
+          product(pair.a * pair.b)
+    {
+    }
+};
+
+// ------------------------------------readStage--------------------------------
+// Description: Parses pairs from input until it runs out, then closes the
+//              queue so the next stage knows to finish.
+//              Running out is only normal between pairs. If a read fails,
+//              or input ends partway through a pair, the pair's number is
+//              put in badPair (otherwise it is left at 0) and reading
+//              stops there.
+// -----------------------------------------------------------------------------
+static void readStage(std::istream &input, BoundedQueue<PolyPair*> &output,
+                      long &badPair)
+{
+    long number = 0;
+
+    while (true)
+    {
+        // Nothing but white space left, so the last pair was complete.
+        if ((input >> std::ws).eof())
+        {
+            break;
+        }
+
+        PolyPair* pair = new PolyPair;
+        pair->number = ++number;
+
+        if (!(input >> pair->a) || !(input >> pair->b))
+        {
+            badPair = pair->number;
+            delete pair;
+            break;
+        }
+
+        output.push(pair);
+    }
+
+    output.close();
+}
+
+// ------------------------------------computeStage-----------------------------
+// Description: Does the arithmetic on each pair.
+// -----------------------------------------------------------------------------
+static void computeStage(BoundedQueue<PolyPair*> &input,
+                         BoundedQueue<PairResult*> &output)
+{
+    PolyPair* pair = NULL;
+
+    while (input.pop(pair))
+    {
+        output.push(new PairResult(*pair));
+        delete pair;
+    }
+
+    output.close();
+}
+
+// ------------------------------------formatStage------------------------------
+// Description: Turns each result into the text for it, in the same
+//              "X =" style as main.cpp.
+// -----------------------------------------------------------------------------
+static void formatStage(BoundedQueue<PairResult*> &input,
+                        BoundedQueue<std::string*> &output)
+{
+    PairResult* result = NULL;
+
+    while (input.pop(result))
+    {
+        std::ostringstream text;
+
+        text << "Pair " << result->number << std::endl
+             << "A =" << result->a << std::endl
+             << "B =" << result->b << std::endl
+             << "A + B =" << result->sum << std::endl
+             << "A - B =" << result->difference << std::endl
+             << "A * B =" << result->product << std::endl << std::endl;
+
+        output.push(new std::string(text.str()));
+        delete result;
+    }
+
+    output.close();
+}
+
+// ------------------------------------writeStage-------------------------------
+// Description: Writes the formatted text out.
+// -----------------------------------------------------------------------------
+static void writeStage(BoundedQueue<std::string*> &input, std::ostream &output)
+{
+    std::string* text = NULL;
+
+    while (input.pop(text))
+    {
+        output << *text;
+        delete text;
+    }
+
+    output.flush();
+}
+
+int main(int argc, char* argv[])
+{
+    long queueCapacity = 64;
+
+    if (argc > 1)
+    {
+        queueCapacity = std::atol(argv[1]);
+
+        if (queueCapacity <= 0)
+        {
+            std::cerr << "usage: " << argv[0] << " [queueCapacity] < pairs"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    // Parsing never needs to wait on output, so do not tie cin to cout.
+    std::ios_base::sync_with_stdio(false);
+    std::cin.tie(NULL);
+
+    BoundedQueue<PolyPair*> parsed(queueCapacity);
+    BoundedQueue<PairResult*> computed(queueCapacity);
+    BoundedQueue<std::string*> formatted(queueCapacity);
+    long badPair = 0;
+
+    std::thread reader(readStage, std::ref(std::cin), std::ref(parsed),
+                       std::ref(badPair));
+    std::thread computer(computeStage, std::ref(parsed), std::ref(computed));
+    std::thread formatter(formatStage, std::ref(computed),
+                          std::ref(formatted));
+
+    writeStage(formatted, std::cout);
+
+    reader.join();
+    computer.join();
+    formatter.join();
+
+    if (badPair != 0)
+    {
+        std::cerr << argv[0] << ": malformed or incomplete input in pair "
+                  << badPair << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+// ------------------------------------------------ polybench.cpp --------------
+// Purpose - Benchmark of Poly's tiled multiply against the plain i/j loop
+//              for the degrees where it matters (hundreds to thousands).
+// -----------------------------------------------------------------------------
+// Usage -
+//
+//   g++ -std=c++11 -O2 polybench.cpp Poly.cpp -o polybench
+//   ./polybench [repeats]
+//
+// Features -
+//
+// - Prints the autotuned tile size, then for each degree the best of
+//   repeats (default 5) runs of multiplySchoolbook, multiplyTiled at the
+//   autotuned size, and multiplyTiled at every size in
+//   Poly::TILE_SIZE_CANDIDATES.
+// - Checks every tiled product against the plain one, and exits with 1
+//   if any differ.
+// -----------------------------------------------------------------------------
+
+#include "Poly.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+typedef std::chrono::steady_clock Clock;
+
+// ------------------------------------benchmarkPoly----------------------------
+// Description: A dense polynomial of the given degree with small mixed
+//              sign coefficients.
+// -----------------------------------------------------------------------------
+static Poly benchmarkPoly(int degree, int seed)
+{
+    Poly result(1 + seed % 5, degree);
+
+    for (int i = 0; i < degree; i++)
+    {
+        result.setCoeff(((i * 31 + seed) % 19) - 9, i);
+    }
+
+    return result;
+}
+
+// ------------------------------------bestSeconds------------------------------
+// Description: Best time of repeats runs of a * b with the given tile
+//              size, 0 meaning multiplySchoolbook. Also returns the product.
+// -----------------------------------------------------------------------------
+static double bestSeconds(const Poly &a, const Poly &b, int tileSize,
+                          int repeats, Poly &product)
+{
+    double best = 0.0;
+
+    for (int r = 0; r < repeats; r++)
+    {
+        Clock::time_point start = Clock::now();
+
+        product = (tileSize == 0) ? a.multiplySchoolbook(b)
+                                  : a.multiplyTiled(b, tileSize);
+
+        double seconds =
+            std::chrono::duration<double>(Clock::now() - start).count();
+
+        if ((r == 0) || (seconds < best))
+        {
+            best = seconds;
+        }
+    }
+
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    int repeats = (argc > 1) ? std::atoi(argv[1]) : 5;
+    static const int degrees[] = { 128, 256, 512, 1024, 2048, 4096, 8192 };
+    bool allMatch = true;
+
+    if (repeats <= 0)
+    {
+        std::cerr << "usage: " << argv[0] << " [repeats]" << std::endl;
+        return 1;
+    }
+
+    int tunedSize = Poly::getTileSize();
+
+    std::cout << "Autotuned tile size: " << tunedSize << std::endl
+              << std::endl
+              << std::setw(8) << "degree" << std::setw(14) << "plain ms"
+              << std::setw(14) << "tiled ms" << std::setw(10) << "speedup";
+
+    for (int k = 0; k < Poly::TILE_SIZE_CANDIDATE_COUNT; k++)
+    {
+        std::cout << std::setw(7) << "T=" << std::left << std::setw(4)
+                  << Poly::TILE_SIZE_CANDIDATES[k] << std::right;
+    }
+
+    std::cout << std::endl << std::fixed;
+
+    for (unsigned d = 0; d < sizeof(degrees) / sizeof(degrees[0]); d++)
+    {
+        Poly a = benchmarkPoly(degrees[d], 1);
+        Poly b = benchmarkPoly(degrees[d], 2);
+        Poly plain;
+        Poly tiled;
+
+        double plainSeconds = bestSeconds(a, b, 0, repeats, plain);
+        double tiledSeconds = bestSeconds(a, b, tunedSize, repeats, tiled);
+
+        allMatch = allMatch && (plain == tiled);
+
+        std::cout << std::setw(8) << degrees[d]
+                  << std::setw(14) << std::setprecision(3)
+                  << plainSeconds * 1000.0
+                  << std::setw(14) << tiledSeconds * 1000.0
+                  << std::setw(9) << std::setprecision(2)
+                  << plainSeconds / tiledSeconds << 'x';
+
+        // Speedup at each fixed tile size, to show what autotuning chose.
+        for (int k = 0; k < Poly::TILE_SIZE_CANDIDATE_COUNT; k++)
+        {
+            double seconds = bestSeconds(a, b, Poly::TILE_SIZE_CANDIDATES[k],
+                                         repeats, tiled);
+
+            allMatch = allMatch && (plain == tiled);
+
+            std::cout << std::setw(10) << std::setprecision(2)
+                      << plainSeconds / seconds << 'x';
+        }
+
+        std::cout << std::endl;
+    }
+
+    if (!allMatch)
+    {
+        std::cout << "Tiled product differs from the plain loop." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
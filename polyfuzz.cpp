@@ -0,0 +1,67 @@
+// ------------------------------------------------ polyfuzz.cpp ---------------
+// Purpose - libFuzzer target that feeds fuzzer generated pairs of
+//              polynomials to PolyCheck, so any fast path that drifts from
+//              Poly's results is found and saved as a crash input.
+// -----------------------------------------------------------------------------
+// Usage -
+//
+//   clang++ -std=c++11 -g -O1 -pthread -fsanitize=fuzzer,address
+//       polyfuzz.cpp PolyCheck.cpp NumPoly.cpp MultiPoly.cpp Poly.cpp
+//       -o polyfuzz
+//   ./polyfuzz [corpus directory]
+//
+// Input format -
+//
+// - Byte 0 picks where the rest of the input is cut into A and B.
+// - Every other byte is one coefficient (as a signed char), from x^0 up.
+//   Zero bytes give sparse polynomials.
+// -----------------------------------------------------------------------------
+
+#include "PolyCheck.h"
+
+#include <cstdlib>
+#include <stddef.h>
+#include <stdint.h>
+
+// ------------------------------------decodePoly-------------------------------
+// Description: Builds the polynomial with coefficients bytes[0 .. count-1].
+// -----------------------------------------------------------------------------
+static Poly decodePoly(const uint8_t* bytes, size_t count)
+{
+    if (count == 0)
+    {
+        return Poly();
+    }
+
+    // Starting at the largest power allocates the array once.
+    Poly result((signed char)bytes[count - 1], int(count - 1));
+
+    for (size_t i = 0; i + 1 < count; i++)
+    {
+        result.setCoeff((signed char)bytes[i], int(i));
+    }
+
+    return result;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    static PolyCheck checker;
+
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    size_t split = 1 + (size - 1) * data[0] / 255;
+    Poly a = decodePoly(data + 1, split - 1);
+    Poly b = decodePoly(data + split, size - split);
+
+    if (!checker.check(a, b, std::cerr))
+    {
+        std::cerr << "A =" << a << std::endl << "B =" << b << std::endl;
+        std::abort();
+    }
+
+    return 0;
+}
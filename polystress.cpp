@@ -0,0 +1,171 @@
+// ------------------------------------------------ polystress.cpp -------------
+// Purpose - Randomized differential and stress runner for the fast
+//              polynomial paths, with Poly as the reference.
+// -----------------------------------------------------------------------------
+// Usage -
+//
+//   g++ -std=c++11 -O2 -pthread polystress.cpp PolyCheck.cpp NumPoly.cpp
+//       MultiPoly.cpp Poly.cpp -o polystress
+//   ./polystress [maxDegree] [randomPairs] [seed]
+//
+// Defaults are maxDegree 1000000, randomPairs 2000, seed 1.
+//
+// Features -
+//
+// - First checks randomPairs small random pairs (degree up to 64, dense
+//   or sparse) on every path.
+// - Then runs the root finder on ROOT_POLYS small polynomials, a third of
+//   them with repeated roots, and checks the residuals.
+// - Then checks one dense pair at each degree 10, 100, 1000, ... up to
+//   maxDegree, and prints each path's time at that degree. Degrees too
+//   big for the O(n*m) paths only run the FFT, checked modulo a prime.
+// - Prints every mismatch and exits with 1 if there were any, so drift
+//   and slowdowns show up in the same run.
+// -----------------------------------------------------------------------------
+
+#include "PolyCheck.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Coefficients are kept this small so Poly's int products of degree
+// 10^6 polynomials cannot overflow.
+static const int MAX_COEFF = 9;
+
+// Number and largest degree of the polynomials given to the root finder.
+static const int ROOT_POLYS = 300;
+static const int ROOT_MAX_DEGREE = 40;
+
+// ------------------------------------randomPoly-------------------------------
+// Description: A random polynomial of exactly the given degree, where each
+//              lower power has a non-zero coefficient with chance density.
+// -----------------------------------------------------------------------------
+static Poly randomPoly(std::mt19937_64 &random, int degree, double density)
+{
+    std::uniform_int_distribution<int> magnitude(1, MAX_COEFF);
+    std::uniform_int_distribution<int> sign(0, 1);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+
+    Poly result(magnitude(random) * (sign(random) ? 1 : -1), degree);
+
+    for (int i = 0; i < degree; i++)
+    {
+        if (chance(random) < density)
+        {
+            result.setCoeff(magnitude(random) * (sign(random) ? 1 : -1), i);
+        }
+    }
+
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    long maxDegree = (argc > 1) ? std::atol(argv[1]) : 1000000;
+    long randomPairs = (argc > 2) ? std::atol(argv[2]) : 2000;
+    unsigned long long seed = (argc > 3) ? std::strtoull(argv[3], NULL, 10) : 1;
+
+    if ((maxDegree < 0) || (randomPairs < 0))
+    {
+        std::cerr << "usage: " << argv[0]
+                  << " [maxDegree] [randomPairs] [seed]" << std::endl;
+        return 1;
+    }
+
+    std::mt19937_64 random(seed);
+    PolyCheck checker(2e8, seed);
+    long failures = 0;
+
+    // Small random pairs
+    std::uniform_int_distribution<int> smallDegree(0, 64);
+    std::uniform_real_distribution<double> density(0.0, 1.0);
+
+    for (long n = 0; n < randomPairs; n++)
+    {
+        Poly a = randomPoly(random, smallDegree(random), density(random));
+        Poly b = randomPoly(random, smallDegree(random), density(random));
+
+        if (!checker.check(a, b, std::cout))
+        {
+            std::cout << "A =" << a << std::endl
+                      << "B =" << b << std::endl << std::endl;
+        }
+    }
+
+    std::cout << "Random pairs: " << checker.getPairs() << ", failed: "
+              << checker.getFailures() << std::endl;
+    checker.printTimes(std::cout);
+    std::cout << std::endl;
+    failures += checker.getFailures();
+
+    // Roots of small random polynomials, every third one a square or
+    // a cube so that it has repeated roots.
+    std::uniform_int_distribution<int> rootDegree(1, ROOT_MAX_DEGREE);
+    std::vector<Poly> rootPolys(ROOT_POLYS);
+
+    for (int p = 0; p < ROOT_POLYS; p++)
+    {
+        if (p % 3 == 0)
+        {
+            Poly factor = randomPoly(random, rootDegree(random) / 3 + 1, 1.0);
+            rootPolys[p] = factor * factor;
+
+            if (p % 6 == 0)
+            {
+                rootPolys[p] *= factor;
+            }
+        }
+        else
+        {
+            rootPolys[p] = randomPoly(random, rootDegree(random),
+                                      density(random));
+        }
+    }
+
+    checker.resetTimes();
+    checker.checkRoots(&rootPolys[0], ROOT_POLYS, std::cout);
+
+    std::cout << "Root finding: " << ROOT_POLYS << " polynomials, failed: "
+              << checker.getFailures() << std::endl << std::endl;
+    failures += checker.getFailures();
+
+    // One large dense pair per degree
+    for (long degree = 10; ; degree *= 10)
+    {
+        if (degree > maxDegree)
+        {
+            if (degree / 10 == maxDegree)
+            {
+                break;
+            }
+
+            degree = maxDegree;
+        }
+
+        checker.resetTimes();
+
+        Poly a = randomPoly(random, int(degree), 1.0);
+        Poly b = randomPoly(random, int(degree), 1.0);
+
+        checker.check(a, b, std::cout);
+
+        std::cout << "Degree " << degree << ": "
+                  << (checker.getFailures() == 0 ? "ok" : "FAILED")
+                  << std::endl;
+        checker.printTimes(std::cout);
+        std::cout << std::endl;
+        failures += checker.getFailures();
+
+        if (degree == maxDegree)
+        {
+            break;
+        }
+    }
+
+    std::cout << (failures == 0 ? "All paths match Poly." : "MISMATCHES FOUND.")
+              << std::endl;
+
+    return (failures == 0) ? 0 : 1;
+}